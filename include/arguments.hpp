@@ -0,0 +1,103 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "manifest.hpp"
+#include "rules.hpp"
+
+// The ${...} placeholders the launcher fills in, see argumentvariablename().
+//
+enum class argumentvariable : uint32_t
+{
+    auth_player_name,
+    version_name,
+    game_directory,
+    assets_root,
+    game_assets,
+    assets_index_name,
+    auth_uuid,
+    auth_access_token,
+    auth_session,
+    auth_xuid,
+    clientid,
+    user_type,
+    user_properties,
+    version_type,
+    natives_directory,
+    library_directory,
+    classpath,
+    classpath_separator,
+    launcher_name,
+    launcher_version,
+    resolution_width,
+    resolution_height,
+    count
+};
+
+// Values for every placeholder of one launch.
+//
+class argumentvalues
+{
+public:
+    void set(argumentvariable variable, std::string value);
+    const std::string& get(argumentvariable variable) const;
+
+private:
+    std::array<std::string, static_cast<size_t>(argumentvariable::count)> values;
+};
+
+// The game and JVM arguments of a version, compiled once into tokens.
+// A token is either literal text or a placeholder, so expanding the arguments for a launch
+// is one pass that appends literals and looks placeholders up by index.
+// Literal text points into the manifest, which has to outlive the template.
+//
+class argumenttemplate
+{
+public:
+    argumenttemplate() = default;
+    argumenttemplate(const versionmanifest& manifest);
+public:
+    // Appends the arguments whose rules allow them on this host.
+    //
+    void expandjvm(const argumentvalues& values, const platform& host, std::vector<std::string>& argv) const;
+    void expandgame(const argumentvalues& values, const platform& host, std::vector<std::string>& argv) const;
+
+private:
+    struct token
+    {
+        std::string_view literal;
+        argumentvariable variable = argumentvariable::count;
+    };
+    // One manifest argument: its rules and the tokens of each of its values.
+    //
+    struct argument
+    {
+        uint32_t firstrule = 0;
+        uint32_t rulecount = 0;
+        uint32_t firstvalue = 0;
+        uint32_t valuecount = 0;
+    };
+    struct valuerange
+    {
+        uint32_t firsttoken = 0;
+        uint32_t tokencount = 0;
+    };
+    void compile(const table<manifestargument>& source, std::vector<argument>& target);
+    void compilevalue(std::string_view text);
+    void expand(const std::vector<argument>& source, const argumentvalues& values, const platform& host, std::vector<std::string>& argv) const;
+
+    const versionmanifest* manifest = nullptr;
+    rulepatterns patterns;
+    std::vector<argument> jvm;
+    std::vector<argument> game;
+    std::vector<valuerange> ranges;
+    std::vector<token> tokens;
+};
@@ -0,0 +1,93 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <curl/curl.h>
+
+// A single file to fetch.
+//
+// sha1 and size are optional, when set the file is verified while it streams in.
+//
+struct downloadtask
+{
+    std::string url;
+    std::string outputpath;
+    std::string sha1;
+    uint64_t size = 0;
+};
+
+// Process-wide curl state shared by every transfer.
+// Easy handles are pooled, DNS and TLS-session caches live in one CURLSH.
+//
+class transfercontext
+{
+public:
+    static transfercontext& get();
+    ~transfercontext();
+    transfercontext(const transfercontext&) = delete;
+    transfercontext& operator=(const transfercontext&) = delete;
+public:
+    // Returns a pooled easy handle with the shared options applied.
+    //
+    CURL* acquire();
+    void release(CURL* curl);
+    // Multi handle of the calling thread. It lives as long as the thread, so its
+    // connection cache carries over from one batch to the next.
+    //
+    CURLM* multihandle();
+
+private:
+    transfercontext();
+    static void lockcallback(CURL* curl, curl_lock_data data, curl_lock_access access, void* userptr);
+    static void unlockcallback(CURL* curl, curl_lock_data data, void* userptr);
+    CURLSH* share = nullptr;
+    std::mutex locks[CURL_LOCK_DATA_LAST];
+    std::mutex poolmutex;
+    std::vector<CURL*> pool;
+    // Contents of cacert.pem, loaded once and handed to curl as a blob.
+    //
+    std::string cacert;
+};
+
+class downloader
+{
+public:
+    downloader
+    (
+        long maxconnections = 8,
+        std::function<void(const std::string&)> logger = nullptr
+    );
+public:
+    // Downloads every task in the batch concurrently and returns the number of failed transfers.
+    //
+    size_t run(const std::vector<downloadtask>& tasks);
+    // Fully hash files that already exist instead of only comparing their size.
+    //
+    void setverify(bool enabled);
+    // Only log a summary instead of a line per file, used for the thousands of asset objects.
+    //
+    void setquiet(bool enabled);
+    // Called on the downloading thread for every task whose file is in place, keep it short.
+    //
+    void setoncomplete(std::function<void(const downloadtask&)> callback);
+    // Number of files the last run() actually wrote.
+    //
+    size_t placedfiles() const;
+
+private:
+    bool isuptodate(const downloadtask& task);
+    long maxconnections;
+    bool verify = false;
+    bool quiet = false;
+    std::function<void(const downloadtask&)> oncomplete;
+    size_t placed = 0;
+    std::function<void(const std::string&)> logconsole;
+};
@@ -0,0 +1,54 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What the GC log of one game session showed.
+//
+struct gcsession
+{
+    int64_t time = 0;
+    uint64_t heapmb = 0;
+    // Largest heap occupancy right after a collection, the closest the log gets to the live set.
+    //
+    uint64_t peaklivemb = 0;
+    uint64_t pauses = 0;
+    double totalpausems = 0;
+    double maxpausems = 0;
+};
+
+// GC statistics of the last sessions of a version, kept in versions/<id>/gchistory.json.
+// The launcher logs GC activity to a file while the game runs, parses it once the game
+// exits and sizes the heap of the next launch from the working set it saw.
+//
+class gchistory
+{
+public:
+    gchistory(const std::string& path);
+public:
+    const std::vector<gcsession>& sessions() const;
+    // Appends a session and writes the file, only the newest ones are kept.
+    //
+    void add(const gcsession& session);
+    // Heap size for the next launch, 0 while there is no history.
+    //
+    uint64_t recommendedheapmb() const;
+    // One line for the UI, e.g. "3 sessions, peak live 812M, max pause 14.2 ms, next heap 1536M".
+    //
+    std::string summary() const;
+    // Reads a log written with -Xlog:gc,gc+phases:file=<path>:tags.
+    //
+    static gcsession parselog(const std::string& logpath);
+
+private:
+    void load();
+    void save() const;
+    std::string path;
+    std::vector<gcsession> entries;
+};
@@ -12,13 +12,42 @@
 #include <fstream>
 #include <string>
 #include <thread>
-#include <windows.h>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <atomic>
 #include <curl/curl.h>
 #include <zip.h>
 #include <nlohmann/json.hpp>
+#include "download.hpp"
+#include "store.hpp"
+#include "taskgraph.hpp"
+#include "manifest.hpp"
+#include "arguments.hpp"
+#include "jvmtuning.hpp"
+#include "gchistory.hpp"
+#include "process.hpp"
+#include "lineframer.hpp"
+#include "rules.hpp"
+#include "sha1.hpp"
 extern std::atomic<bool> minecraftrunning;
 
+// One library on the classpath, keyed by "group:artifact[:classifier]".
+//
+struct classpathentry
+{
+    std::string key;
+    std::string version;
+    std::string path;
+};
+
 class launcher
 {
 public:
@@ -28,20 +57,83 @@ public:
         std::function<void(const std::string&)> logger = nullptr
     );
 public:
-    void launchprocess(const std::string& username);
+    bool launchprocess(const std::string& username);
+    void setmaxdownloads(long count);
+    void setverifyfiles(bool enabled);
+    void setappcds(bool enabled);
+    void setgclogging(bool enabled);
 
 private:
     static void logger(const std::string& msg);
-    void downloadfiles(const std::string& url, const std::string& outputpath);
+    size_t downloadfiles(const std::vector<downloadtask>& tasks);
+    void downloadfile(const downloadtask& task);
+    // Setup steps, each one is a node of the graph run by setuplauncher().
+    //
+    void downloadmanifest();
+    void downloadversionjson();
+    void downloadclient();
+    void downloadlibraries();
+    void downloadassetindex();
+    void downloadassetobjects();
     void extractnatives(const std::string& jarpath);
-    void setuplauncher();
+    void loadnativesmanifest();
+    void savenativesmanifest(const std::unordered_set<std::string>& usedjars);
+    bool setuplauncher();
+    // Cached launch plan, lets an unchanged install skip the whole setup.
+    //
+    std::string launchfingerprint(const std::string& username, const std::string& javapath);
+    bool loadlaunchplan(const std::string& fingerprint, std::vector<std::string>& argv);
+    void savelaunchplan(const std::string& fingerprint, const std::vector<std::string>& argv);
     std::string getclasspath();
-    std::string buildlaunchcommand(const std::string& username);
+    void appcdsarguments(const std::string& javapath, std::vector<std::string>& argv);
+    std::vector<std::string> buildlaunchcommand(const std::string& username, const std::string& javapath);
     // Version information.
     //
     std::string versionid;
     std::string jsonpath;
     std::string nativespath;
+    std::string assetspath;
+    std::string planpath;
+    // AppCDS archive of this version, appcds.jsa.key holds what it was recorded for.
+    //
+    std::string cdspath;
+    // GC log of the running session and the statistics of earlier ones.
+    //
+    std::string gclogpath;
+    std::string gchistorypath;
+    // Old per-version libraries folder, only read to move jars into the store.
+    //
     std::string libspath;
+    librarystore store;
+    platform host;
+    // Resolved library jars of this version in manifest order.
+    //
+    std::vector<classpathentry> libraries;
+    std::string classpath;
+    // False when getclasspath() had to leave out a missing jar, such a classpath is never cached.
+    //
+    bool classpathcomplete = false;
+    // State handed from one setup step to the next.
+    //
+    std::string versionurl;
+    std::string versionsha1;
+    versionmanifest manifest;
+    std::string assetindexid;
+    std::string assetindexpath;
+    // Contents of natives.json, only touched by the extraction worker.
+    //
+    nlohmann::json nativesmanifest;
+    // Number of parallel transfers used by downloadfiles().
+    //
+    long maxdownloads = 8;
+    // Asset objects are tiny, so many more of them are kept in flight.
+    //
+    long maxassetdownloads = 32;
+    bool verifyfiles = false;
+    bool appcds = true;
+    bool gclogging = true;
+    // Heap and GC settings chosen by launchprocess().
+    //
+    jvmsettings jvm;
     std::function<void(const std::string&)> logconsole;
 };
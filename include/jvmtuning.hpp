@@ -0,0 +1,45 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Memory and cores of the machine the game runs on.
+//
+struct hostresources
+{
+    uint64_t totalmb = 0;
+    uint64_t availablemb = 0;
+    unsigned cores = 1;
+
+    static hostresources current();
+};
+
+// Heap and GC settings picked for one launch.
+//
+struct jvmsettings
+{
+    std::string profile;
+    uint64_t heapmb = 0;
+    uint64_t initialmb = 0;
+    std::string gc;
+    // The options in launch order: -Xmx, -Xms, then the GC flags and any extra ones.
+    //
+    std::vector<std::string> arguments;
+    // One line for the log, e.g. "standard: 4096M heap (2048M initial), g1".
+    //
+    std::string summary() const;
+};
+
+// Picks the first profile of the table the machine is big enough for, fits its heap into the
+// memory that is actually free and falls back to G1 when the runtime has no usable ZGC.
+// learnedheapmb replaces the profile's heap when earlier sessions showed what the version needs.
+// A version can override the profile or single values in versions/<id>/jvm.json:
+//   { "profile": "balanced", "heap": 3072, "initial": 1024, "gc": "g1", "arguments": [ "-XX:+AlwaysPreTouch" ] }
+//
+jvmsettings choosejvmsettings(const hostresources& host, int javamajor, const std::string& overridepath, uint64_t learnedheapmb = 0);
@@ -0,0 +1,39 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+// Called with each complete line, without the line ending. The view is only valid
+// during the call, consumers copy what they want to keep.
+//
+using linehandler = std::function<void(std::string_view line)>;
+
+// Splits a byte stream that arrives in arbitrary chunks (like a pipe) into lines.
+// Lines that lie whole inside a chunk are handed out as views into it, only the unfinished
+// tail of a chunk is copied, into a buffer that is allocated once and reused for the whole stream.
+//
+class lineframer
+{
+public:
+    // Lines longer than capacity that span chunks are split at that length.
+    //
+    lineframer(size_t capacity = 16384);
+public:
+    void feed(const char* data, size_t size, const linehandler& online);
+    // Hands out the last line when the stream ended without a newline.
+    //
+    void flush(const linehandler& online);
+
+private:
+    void emit(const char* data, size_t size, const linehandler& online);
+    std::unique_ptr<char[]> buffer;
+    size_t capacity;
+    size_t pending = 0;
+};
@@ -0,0 +1,132 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queue with any number of producers and a single consumer.
+// Every slot carries a sequence number that tells whose turn it is: producers claim a slot
+// by advancing the tail with a CAS, the consumer takes slots in order without any atomics
+// on the head. When the queue is full push() fails instead of waiting, so a producer never
+// blocks on a slow consumer.
+//
+template <typename T>
+class logqueue
+{
+public:
+    // Capacity is rounded up to a power of two.
+    //
+    logqueue(size_t capacity = 8192)
+    {
+        size = 2;
+        while (size < capacity)
+            size <<= 1;
+        mask = size - 1;
+        slots.reset(new slot[size]);
+        for (size_t i = 0; i < size; i++)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    logqueue(const logqueue&) = delete;
+    logqueue& operator=(const logqueue&) = delete;
+public:
+    // Any thread. Returns false and counts the entry as dropped when the queue is full.
+    //
+    bool push(T value)
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            slot& s = slots[position & mask];
+            size_t sequence = s.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0)
+            {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    s.value = std::move(value);
+                    s.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+                position = tail.load(std::memory_order_relaxed);
+        }
+    }
+    // Consumer thread only. Returns false when nothing is ready.
+    //
+    bool pop(T& value)
+    {
+        slot& s = slots[head & mask];
+        if (s.sequence.load(std::memory_order_acquire) != head + 1)
+            return false;
+        value = std::move(s.value);
+        s.sequence.store(head + size, std::memory_order_release);
+        head++;
+        return true;
+    }
+    // Entries dropped since the last call, consumer thread only.
+    //
+    size_t takedropped()
+    {
+        return dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct slot
+    {
+        std::atomic<size_t> sequence{ 0 };
+        T value;
+    };
+    std::unique_ptr<slot[]> slots;
+    size_t size = 0;
+    size_t mask = 0;
+    size_t head = 0;
+    // Producers and consumer touch different ends, keep them off one cache line.
+    //
+    alignas(64) std::atomic<size_t> tail{ 0 };
+    alignas(64) std::atomic<size_t> dropped{ 0 };
+};
+
+// Fixed-capacity scrollback that overwrites its oldest entry once full.
+// Entries are indexed oldest first. Storage grows up to the capacity and is reused from then on.
+//
+template <typename T>
+class logring
+{
+public:
+    logring(size_t capacity = 10000)
+        :capacity(capacity > 0 ? capacity : 1)
+    {
+    }
+public:
+    void push(T value)
+    {
+        if (items.size() < capacity)
+        {
+            items.push_back(std::move(value));
+            return;
+        }
+        items[first] = std::move(value);
+        first = (first + 1) % capacity;
+    }
+    size_t size() const { return items.size(); }
+    const T& operator[](size_t index) const { return items[(first + index) % items.size()]; }
+
+private:
+    std::vector<T> items;
+    size_t capacity;
+    size_t first = 0;
+};
@@ -0,0 +1,188 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Reference into the string table of a versionmanifest.
+//
+struct stringref
+{
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+// Read-only view of a flat array owned by a versionmanifest.
+//
+template <typename T>
+struct table
+{
+    const T* data = nullptr;
+    uint32_t count = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + count; }
+    const T& operator[](size_t index) const { return data[index]; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+// A downloadable file, path is empty for files that have no maven path.
+//
+struct manifestartifact
+{
+    stringref path;
+    stringref url;
+    stringref sha1;
+    uint64_t size = 0;
+};
+
+// One entry of a "rules" array, empty strings match anything.
+//
+struct manifestrule
+{
+    uint32_t allow = 1;
+    stringref osname;
+    stringref osarch;
+    stringref osversion;
+    uint32_t firstfeature = 0;
+    uint32_t featurecount = 0;
+};
+
+struct manifestfeature
+{
+    stringref name;
+    uint32_t value = 0;
+};
+
+// Pre-1.19 natives: the classifier to use on an OS, may contain ${arch}.
+//
+struct manifestnative
+{
+    stringref os;
+    stringref classifier;
+};
+
+struct manifestclassifier
+{
+    stringref key;
+    manifestartifact artifact;
+};
+
+struct manifestlibrary
+{
+    stringref name;
+    uint32_t hasartifact = 0;
+    manifestartifact artifact;
+    uint32_t firstrule = 0;
+    uint32_t rulecount = 0;
+    uint32_t firstnative = 0;
+    uint32_t nativecount = 0;
+    uint32_t firstclassifier = 0;
+    uint32_t classifiercount = 0;
+};
+
+// One game or JVM argument, made of one or more values and used when its rules allow it.
+//
+struct manifestargument
+{
+    uint32_t firstvalue = 0;
+    uint32_t valuecount = 0;
+    uint32_t firstrule = 0;
+    uint32_t rulecount = 0;
+};
+
+// One object of an asset index, stored under objects/<xx>/<hash>.
+//
+struct assetobject
+{
+    stringref hash;
+    uint64_t size = 0;
+};
+
+// Strings and tables of a parsed JSON file. They either point into arrays parsed from
+// the JSON or straight into a memory mapped binary cache that was written next to it.
+//
+class flatfile
+{
+public:
+    bool loaded() const;
+    // True when the data came from the binary cache instead of the JSON.
+    //
+    bool cached() const;
+    std::string_view str(stringref ref) const;
+    std::string string(stringref ref) const;
+    // Keeps the memory the tables point into alive.
+    //
+    struct owner
+    {
+        virtual ~owner() = default;
+    };
+
+protected:
+    const char* strings = nullptr;
+    uint32_t stringsize = 0;
+    bool frommapping = false;
+    std::unique_ptr<owner> owned;
+};
+
+// The parts of a version JSON the launcher uses, parsed once into flat arrays.
+// Every string lives once in a shared string table and is referenced by offset,
+// so the setup steps read it without hashing or copying.
+//
+class versionmanifest : public flatfile
+{
+public:
+    // Maps the binary cache next to the JSON when it was written for the same content,
+    // otherwise parses the JSON and writes the cache. Throws std::runtime_error when it can't.
+    //
+    static versionmanifest load(const std::string& jsonpath);
+
+    stringref id;
+    stringref type;
+    stringref mainclass;
+    stringref assets;
+    stringref assetindexid;
+    manifestartifact assetindex;
+    manifestartifact client;
+    stringref javacomponent;
+    uint32_t javamajor = 0;
+    // minecraftArguments of versions before 1.13, split on spaces into gamearguments.
+    //
+    uint32_t legacyarguments = 0;
+    table<manifestlibrary> libraries;
+    table<manifestrule> rules;
+    table<manifestfeature> features;
+    table<manifestnative> natives;
+    table<manifestclassifier> classifiers;
+    table<manifestargument> gamearguments;
+    table<manifestargument> jvmarguments;
+    table<stringref> argumentvalues;
+
+private:
+    static versionmanifest parse(const std::string& jsonpath);
+    bool map(const std::string& cachepath, const std::string& sha1);
+    void save(const std::string& cachepath, const std::string& sha1) const;
+};
+
+// The objects of an asset index, loaded the same way as a versionmanifest.
+// Objects with the same hash share one string, so their hash refs compare equal.
+//
+class assetmanifest : public flatfile
+{
+public:
+    static assetmanifest load(const std::string& jsonpath);
+
+    table<assetobject> objects;
+
+private:
+    static assetmanifest parse(const std::string& jsonpath);
+    bool map(const std::string& cachepath, const std::string& sha1);
+    void save(const std::string& cachepath, const std::string& sha1) const;
+};
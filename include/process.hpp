@@ -0,0 +1,78 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// How to start a child process. argv[0] is the program to run.
+//
+struct processoptions
+{
+    std::vector<std::string> argv;
+    // "NAME=value" entries, empty means the child inherits the launcher's environment.
+    //
+    std::vector<std::string> env;
+    // Working directory, empty means the launcher's own.
+    //
+    std::string cwd;
+};
+
+enum class outputstream
+{
+    output,
+    error
+};
+
+// Called from pump() with each piece of output as it arrives.
+//
+using outputhandler = std::function<void(outputstream stream, const char* data, size_t size)>;
+
+// A child process with its stdout and stderr connected to pipes.
+// Backed by CreateProcess on Windows and posix_spawn (plus a pidfd on Linux) elsewhere.
+//
+class childprocess
+{
+public:
+    childprocess() = default;
+    ~childprocess();
+    childprocess(const childprocess&) = delete;
+    childprocess& operator=(const childprocess&) = delete;
+public:
+    // Starts the process, returns false and sets error() when it can't.
+    //
+    bool start(const processoptions& options);
+    const std::string& error() const;
+    // Drains stdout and stderr from the calling thread as data arrives and watches for the
+    // child to exit, so neither pipe can fill up and stall it. Returns the exit code.
+    // Runs on overlapped named pipes with WaitForMultipleObjects on Windows and on
+    // epoll over the pipes and the pidfd on Linux.
+    //
+    int pump(const outputhandler& onoutput);
+    // Waits for the child to exit and returns its exit code, 128 + signal when it was killed.
+    //
+    int wait();
+    long pid() const;
+
+private:
+    void closehandles();
+    std::string message;
+    bool exited = false;
+    int exitcode = -1;
+#ifdef _WIN32
+    void* process = nullptr;
+    void* output = nullptr;
+    void* errors = nullptr;
+    unsigned long id = 0;
+#else
+    int id = -1;
+    int pidfd = -1;
+    int output = -1;
+    int errors = -1;
+#endif
+};
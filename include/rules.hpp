@@ -0,0 +1,57 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <string>
+#include <map>
+#include <regex>
+#include <vector>
+#include "manifest.hpp"
+
+// The machine the game is launched on, as seen by the "rules" arrays of a version JSON.
+//
+struct platform
+{
+    std::string os;
+    std::string arch;
+    std::string version;
+    std::map<std::string, bool> features;
+
+    static platform current();
+    // Classifier of the natives jars built for this machine, e.g. "natives-windows-arm64".
+    //
+    std::string nativesclassifier() const;
+    // True for the shared library files natives jars contain on this OS.
+    //
+    bool isnativelibrary(const std::string& filename) const;
+};
+
+// The os.version patterns of a manifest's rules, compiled once so evaluating rules
+// never builds a regex. Indexed like manifest.rules.
+//
+class rulepatterns
+{
+public:
+    rulepatterns() = default;
+    rulepatterns(const versionmanifest& manifest);
+public:
+    // True when the rule has no os.version pattern or the pattern matches version.
+    //
+    bool versionmatches(uint32_t rule, const std::string& version) const;
+
+private:
+    // Per rule: index into compiled, or one of the values below.
+    //
+    static constexpr int32_t nopattern = -1;
+    static constexpr int32_t invalidpattern = -2;
+    std::vector<int32_t> indices;
+    std::vector<std::regex> compiled;
+};
+
+// Evaluates a "rules" array the way the vanilla launcher does: nothing is allowed
+// until a rule matches, and the last matching rule decides. No rules means allowed.
+//
+bool rulesallow(const versionmanifest& manifest, const rulepatterns& patterns, uint32_t firstrule, uint32_t rulecount, const platform& host);
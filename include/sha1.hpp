@@ -0,0 +1,33 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Incremental SHA-1, used to verify downloads while they stream in.
+//
+class sha1hash
+{
+public:
+    sha1hash();
+public:
+    void update(const void* data, size_t length);
+    // Finishes the hash and returns it as 40 lowercase hex characters.
+    //
+    std::string hexdigest();
+    // Hashes a whole file, returns an empty string when it can't be read.
+    //
+    static std::string file(const std::string& path);
+
+private:
+    void transform(const uint8_t* block);
+    uint32_t state[5];
+    uint8_t buffer[64];
+    uint64_t length = 0;
+    size_t buffered = 0;
+};
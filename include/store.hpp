@@ -0,0 +1,34 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <cstdint>
+#include <string>
+
+// Library store shared by every installed version.
+// Artifacts with a known sha1 live under <root>/<xx>/<sha1>/<filename>, so two versions
+// that use the same jar resolve to the same file and it is only downloaded once.
+// Artifacts without a hash fall back to their maven path under <root>/maven.
+//
+class librarystore
+{
+public:
+    librarystore(const std::string& root);
+public:
+    std::string resolve(const std::string& artifactpath, const std::string& sha1) const;
+    // Moves a jar from an old per-version libraries folder into the store.
+    //
+    bool adopt(const std::string& legacypath, const std::string& storepath) const;
+    const std::string& path() const;
+    // Counter that changes whenever files were added to the store, cached launch plans
+    // use it to notice that the libraries they point at may have changed.
+    //
+    uint64_t generation() const;
+    void bumpgeneration() const;
+
+private:
+    std::string root;
+};
@@ -0,0 +1,38 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+#pragma once
+
+// Dependency headers.
+//
+#include <string>
+#include <vector>
+#include <functional>
+
+// Small dependency graph of setup steps.
+// A node starts on a worker thread as soon as every node it depends on has finished.
+// When a node throws, everything that depends on it is skipped.
+//
+class taskgraph
+{
+public:
+    using nodeid = size_t;
+    taskgraph(std::function<void(const std::string&)> logger = nullptr);
+public:
+    nodeid add(const std::string& name, std::function<void()> work, const std::vector<nodeid>& dependencies = {});
+    // Runs the whole graph and returns false if any node failed or was skipped.
+    //
+    bool run(size_t workers);
+
+private:
+    struct node
+    {
+        std::string name;
+        std::function<void()> work;
+        std::vector<nodeid> dependents;
+        size_t remaining = 0;
+        bool skipped = false;
+    };
+    std::vector<node> nodes;
+    std::function<void(const std::string&)> logconsole;
+};
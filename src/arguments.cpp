@@ -0,0 +1,164 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/arguments.hpp"
+
+// Placeholder names in the same order as argumentvariable.
+//
+static const char* const variablenames[] =
+{
+    "auth_player_name",
+    "version_name",
+    "game_directory",
+    "assets_root",
+    "game_assets",
+    "assets_index_name",
+    "auth_uuid",
+    "auth_access_token",
+    "auth_session",
+    "auth_xuid",
+    "clientid",
+    "user_type",
+    "user_properties",
+    "version_type",
+    "natives_directory",
+    "library_directory",
+    "classpath",
+    "classpath_separator",
+    "launcher_name",
+    "launcher_version",
+    "resolution_width",
+    "resolution_height",
+};
+static_assert(sizeof(variablenames) / sizeof(variablenames[0]) == static_cast<size_t>(argumentvariable::count),
+    "variablenames must list every argumentvariable");
+
+// JVM arguments of versions before 1.13, which only have minecraftArguments.
+//
+static const char* const legacyjvmarguments[] =
+{
+    "-Djava.library.path=${natives_directory}",
+    "-cp",
+    "${classpath}",
+};
+
+static argumentvariable findvariable(std::string_view name)
+{
+    for (size_t i = 0; i < static_cast<size_t>(argumentvariable::count); i++)
+    {
+        if (name == variablenames[i])
+            return static_cast<argumentvariable>(i);
+    }
+    return argumentvariable::count;
+}
+
+void argumentvalues::set(argumentvariable variable, std::string value)
+{
+    values[static_cast<size_t>(variable)] = std::move(value);
+}
+
+const std::string& argumentvalues::get(argumentvariable variable) const
+{
+    return values[static_cast<size_t>(variable)];
+}
+
+argumenttemplate::argumenttemplate(const versionmanifest& manifest)
+    :manifest(&manifest), patterns(manifest)
+{
+    compile(manifest.jvmarguments, jvm);
+    compile(manifest.gamearguments, game);
+    if (manifest.jvmarguments.empty())
+    {
+        argument entry;
+        entry.firstvalue = static_cast<uint32_t>(ranges.size());
+        for (const char* text : legacyjvmarguments)
+        {
+            compilevalue(text);
+            entry.valuecount++;
+        }
+        jvm.push_back(entry);
+    }
+}
+
+void argumenttemplate::compile(const table<manifestargument>& source, std::vector<argument>& target)
+{
+    target.reserve(source.size());
+    for (const auto& entry : source)
+    {
+        argument compiled;
+        compiled.firstrule = entry.firstrule;
+        compiled.rulecount = entry.rulecount;
+        compiled.firstvalue = static_cast<uint32_t>(ranges.size());
+        compiled.valuecount = entry.valuecount;
+        for (uint32_t i = 0; i < entry.valuecount; i++)
+            compilevalue(manifest->str(manifest->argumentvalues[entry.firstvalue + i]));
+        target.push_back(compiled);
+    }
+}
+
+// This function splits one argument value into literal text and ${...} placeholders.
+// Unknown placeholders are kept as text, like the vanilla launcher does.
+//
+void argumenttemplate::compilevalue(std::string_view text)
+{
+    valuerange range;
+    range.firsttoken = static_cast<uint32_t>(tokens.size());
+    size_t position = 0;
+    while (position < text.size())
+    {
+        size_t open = text.find("${", position);
+        size_t close = open == std::string_view::npos ? open : text.find('}', open + 2);
+        argumentvariable variable = close == std::string_view::npos
+            ? argumentvariable::count
+            : findvariable(text.substr(open + 2, close - open - 2));
+        if (variable == argumentvariable::count)
+        {
+            // No known placeholder left, the text up to the next one (or the end) is literal.
+            //
+            size_t end = close == std::string_view::npos ? text.size() : close + 1;
+            tokens.push_back({ text.substr(position, end - position), argumentvariable::count });
+            position = end;
+            continue;
+        }
+        if (open > position)
+            tokens.push_back({ text.substr(position, open - position), argumentvariable::count });
+        tokens.push_back({ std::string_view(), variable });
+        position = close + 1;
+    }
+    range.tokencount = static_cast<uint32_t>(tokens.size()) - range.firsttoken;
+    ranges.push_back(range);
+}
+
+void argumenttemplate::expandjvm(const argumentvalues& values, const platform& host, std::vector<std::string>& argv) const
+{
+    expand(jvm, values, host, argv);
+}
+
+void argumenttemplate::expandgame(const argumentvalues& values, const platform& host, std::vector<std::string>& argv) const
+{
+    expand(game, values, host, argv);
+}
+
+void argumenttemplate::expand(const std::vector<argument>& source, const argumentvalues& values, const platform& host, std::vector<std::string>& argv) const
+{
+    for (const auto& entry : source)
+    {
+        if (entry.rulecount > 0 && !rulesallow(*manifest, patterns, entry.firstrule, entry.rulecount, host))
+            continue;
+        for (uint32_t v = 0; v < entry.valuecount; v++)
+        {
+            const valuerange& range = ranges[entry.firstvalue + v];
+            std::string& out = argv.emplace_back();
+            for (uint32_t t = 0; t < range.tokencount; t++)
+            {
+                const token& piece = tokens[range.firsttoken + t];
+                if (piece.variable == argumentvariable::count)
+                    out += piece.literal;
+                else
+                    out += values.get(piece.variable);
+            }
+        }
+    }
+}
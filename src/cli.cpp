@@ -0,0 +1,76 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Headless launcher: installs and starts a version from the command line and reports
+// how long each step took, so launches can be measured without the GUI.
+//
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "../include/java.hpp"
+
+static void usage()
+{
+    printf("usage: cclauncher-cli <version> <username> [--no-wait] [--no-appcds] [--no-gclog] [--verify]\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        usage();
+        return 2;
+    }
+    std::string version = argv[1];
+    std::string username = argv[2];
+    bool wait = true;
+    bool appcds = true;
+    bool gclog = true;
+    bool verify = false;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--no-wait") == 0)
+            wait = false;
+        else if (std::strcmp(argv[i], "--no-appcds") == 0)
+            appcds = false;
+        else if (std::strcmp(argv[i], "--no-gclog") == 0)
+            gclog = false;
+        else if (std::strcmp(argv[i], "--verify") == 0)
+            verify = true;
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+    // Every log line gets the milliseconds since start, so the output doubles as a timeline.
+    //
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [start]()
+    {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    };
+    launcher instance(version, [elapsed](const std::string& msg)
+    {
+        printf("[%7lld ms] %s\n", elapsed(), msg.c_str());
+        fflush(stdout);
+    });
+    instance.setappcds(appcds);
+    instance.setgclogging(gclog);
+    instance.setverifyfiles(verify);
+    minecraftrunning = true;
+    if (!instance.launchprocess(username))
+    {
+        printf("[%7lld ms] launch failed\n", elapsed());
+        return 1;
+    }
+    printf("[%7lld ms] java started\n", elapsed());
+    if (!wait)
+        return 0;
+    while (minecraftrunning)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    printf("[%7lld ms] java exited\n", elapsed());
+    return 0;
+}
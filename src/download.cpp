@@ -0,0 +1,509 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/download.hpp"
+#include "../include/sha1.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+// State for one transfer that is currently attached to the multi handle.
+// Bytes go to partpath and are only moved to the real path once verified.
+//
+struct transfer
+{
+    const downloadtask* task = nullptr;
+    CURL* curl = nullptr;
+    std::string partpath;
+    std::ofstream file;
+    sha1hash hash;
+    uint64_t offset = 0;
+    uint64_t received = 0;
+};
+
+// Temporary sibling file a download is written to.
+//
+static std::string partialpath(const std::string& outputpath)
+{
+    return outputpath + ".part";
+}
+
+// Called by curl every time bytes are downloaded.
+// The bytes are hashed on the way to disk so verifying needs no second read.
+//
+static size_t curlcallback(void* ptr, size_t size, size_t nmemb, void* userdata)
+{
+    transfer* t = reinterpret_cast<transfer*>(userdata);
+    size_t written = size * nmemb;
+    t->file.write(reinterpret_cast<char*>(ptr), written);
+    if (!t->file)
+        return 0;
+    t->hash.update(ptr, written);
+    t->received += written;
+    return written;
+}
+
+// Checks a completed part file and atomically moves it over the real path.
+//
+static bool finishtransfer(transfer& t, const std::function<void(const std::string&)>& logconsole)
+{
+    t.file.close();
+    if ((t.task->size > 0 && t.received != t.task->size)
+        || (!t.task->sha1.empty() && t.hash.hexdigest() != t.task->sha1))
+    {
+        fs::remove(t.partpath);
+        if (logconsole)
+            logconsole("[Error] Verification failed: " + t.task->outputpath);
+        return false;
+    }
+    std::error_code ec;
+    fs::rename(t.partpath, t.task->outputpath, ec);
+    if (ec)
+    {
+        if (logconsole)
+            logconsole("[Error] Failed to move download into place: " + t.task->outputpath + " (" + ec.message() + ")");
+        return false;
+    }
+    return true;
+}
+
+// Sets up curl once for the whole process and loads the bundled CA certificates.
+//
+transfercontext::transfercontext()
+{
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    share = curl_share_init();
+    if (share)
+    {
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockcallback);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockcallback);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        // Connections are not shared here, curl doesn't support one connection cache used
+        // from several threads at once. Each thread keeps its own in multihandle().
+        //
+    }
+    std::ifstream file("cacert.pem", std::ios::binary);
+    if (file)
+    {
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        cacert = contents.str();
+    }
+}
+
+transfercontext::~transfercontext()
+{
+    for (CURL* curl : pool)
+        curl_easy_cleanup(curl);
+    if (share)
+        curl_share_cleanup(share);
+    curl_global_cleanup();
+}
+
+transfercontext& transfercontext::get()
+{
+    static transfercontext context;
+    return context;
+}
+
+void transfercontext::lockcallback(CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+{
+    static_cast<transfercontext*>(userptr)->locks[data].lock();
+}
+
+void transfercontext::unlockcallback(CURL*, curl_lock_data data, void* userptr)
+{
+    static_cast<transfercontext*>(userptr)->locks[data].unlock();
+}
+
+// Hands out a pooled handle, resetting per-transfer options but keeping the shared caches.
+//
+CURL* transfercontext::acquire()
+{
+    CURL* curl = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(poolmutex);
+        if (!pool.empty())
+        {
+            curl = pool.back();
+            pool.pop_back();
+        }
+    }
+    if (curl)
+        curl_easy_reset(curl);
+    else
+        curl = curl_easy_init();
+    if (!curl)
+        return nullptr;
+    if (share)
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+    if (!cacert.empty())
+    {
+        curl_blob blob;
+        blob.data = cacert.data();
+        blob.len = cacert.size();
+        blob.flags = CURL_BLOB_NOCOPY;
+        curl_easy_setopt(curl, CURLOPT_CAINFO_BLOB, &blob);
+    }
+    else
+    {
+        // No bundled certificates, fall back to unverified transfers.
+        //
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    }
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    return curl;
+}
+
+void transfercontext::release(CURL* curl)
+{
+    if (!curl)
+        return;
+    std::lock_guard<std::mutex> lock(poolmutex);
+    pool.push_back(curl);
+}
+
+// Owns the multi handle of one thread and cleans it up when the thread ends.
+//
+struct threadmulti
+{
+    CURLM* multi = nullptr;
+    ~threadmulti()
+    {
+        if (multi)
+            curl_multi_cleanup(multi);
+    }
+};
+
+CURLM* transfercontext::multihandle()
+{
+    thread_local threadmulti holder;
+    if (!holder.multi)
+        holder.multi = curl_multi_init();
+    return holder.multi;
+}
+
+downloader::downloader
+(
+    long maxconnections,
+    std::function<void(const std::string&)> logger
+)
+    :maxconnections(maxconnections > 0 ? maxconnections : 1), logconsole(std::move(logger))
+{
+}
+
+void downloader::setverify(bool enabled)
+{
+    verify = enabled;
+}
+
+void downloader::setquiet(bool enabled)
+{
+    quiet = enabled;
+}
+
+void downloader::setoncomplete(std::function<void(const downloadtask&)> callback)
+{
+    oncomplete = std::move(callback);
+}
+
+size_t downloader::placedfiles() const
+{
+    return placed;
+}
+
+// Checks an existing file against the expected size, and the hash when verify is enabled.
+//
+bool downloader::isuptodate(const downloadtask& task)
+{
+    // One stat answers both "does it exist" and "does the size match".
+    //
+    std::error_code ec;
+    uint64_t existing = fs::file_size(task.outputpath, ec);
+    if (ec)
+        return false;
+    if (task.size > 0 && existing != task.size)
+    {
+        if (logconsole)
+            logconsole("[Warn] Size mismatch, downloading again: " + task.outputpath);
+        return false;
+    }
+    if (verify && !task.sha1.empty() && sha1hash::file(task.outputpath) != task.sha1)
+    {
+        if (logconsole)
+            logconsole("[Warn] Checksum mismatch, downloading again: " + task.outputpath);
+        return false;
+    }
+    return true;
+}
+
+// This function drives all transfers of a batch through one curl multi handle.
+// At most maxconnections transfers are in flight, the next task is added as soon as one finishes.
+//
+size_t downloader::run(const std::vector<downloadtask>& tasks)
+{
+    // Filter out files that already exist and look intact.
+    //
+    placed = 0;
+    std::vector<const downloadtask*> pending;
+    std::unordered_set<std::string> createddirs;
+    pending.reserve(tasks.size());
+    for (const auto& task : tasks)
+    {
+        if (isuptodate(task))
+        {
+            if (logconsole && !quiet)
+                logconsole("[Skip] " + task.outputpath);
+            if (oncomplete)
+                oncomplete(task);
+            continue;
+        }
+        // Many small files share a few folders, only create each one once.
+        //
+        std::string parent = fs::path(task.outputpath).parent_path().string();
+        if (createddirs.insert(parent).second)
+            fs::create_directories(parent);
+        pending.push_back(&task);
+    }
+    if (logconsole && quiet && pending.size() < tasks.size())
+        logconsole("[Skip] " + std::to_string(tasks.size() - pending.size()) + " files up to date");
+    if (pending.empty())
+        return 0;
+
+    transfercontext& context = transfercontext::get();
+    CURLM* multi = context.multihandle();
+    if (!multi)
+        throw std::runtime_error("Failed to initialize curl multi handle.");
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, maxconnections);
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    size_t failed = 0;
+    size_t next = 0;
+    // Statistics for the batch summary.
+    //
+    size_t completed = 0;
+    long newconnections = 0;
+    curl_off_t totalbytes = 0;
+    curl_off_t totaltime = 0;
+    auto batchstart = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<transfer>> inflight;
+    // Tasks whose part was thrown away because the server wouldn't resume it, each gets one fresh try.
+    //
+    std::unordered_set<const downloadtask*> restarted;
+    // Attach the next pending task to the multi handle.
+    //
+    auto addtransfer = [&]()
+    {
+        const downloadtask* task = pending[next++];
+        auto t = std::make_unique<transfer>();
+        t->task = task;
+        t->partpath = partialpath(task->outputpath);
+        // Pick up where an interrupted run stopped.
+        //
+        std::error_code ec;
+        uint64_t partsize = fs::exists(t->partpath, ec) ? fs::file_size(t->partpath, ec) : 0;
+        if (ec || (task->size > 0 && partsize > task->size))
+            partsize = 0;
+        if (partsize > 0)
+        {
+            std::ifstream in(t->partpath, std::ios::binary);
+            char chunk[65536];
+            while (in.read(chunk, sizeof(chunk)) || in.gcount() > 0)
+                t->hash.update(chunk, static_cast<size_t>(in.gcount()));
+            t->offset = partsize;
+            t->received = partsize;
+            t->file.open(t->partpath, std::ios::binary | std::ios::app);
+        }
+        else
+        {
+            t->file.open(t->partpath, std::ios::binary | std::ios::trunc);
+        }
+        if (!t->file)
+        {
+            if (logconsole)
+                logconsole("[Error] Failed to open output file: " + t->partpath);
+            failed++;
+            return;
+        }
+        // The part already holds every byte, it only needs to be verified and moved.
+        //
+        if (task->size > 0 && partsize == task->size)
+        {
+            if (!finishtransfer(*t, logconsole))
+            {
+                failed++;
+                return;
+            }
+            placed++;
+            if (oncomplete)
+                oncomplete(*task);
+            return;
+        }
+        t->curl = context.acquire();
+        if (!t->curl)
+        {
+            if (logconsole)
+                logconsole("[Error] Failed to initialize curl.");
+            t->file.close();
+            failed++;
+            return;
+        }
+        if (logconsole && !quiet)
+        {
+            if (t->offset > 0)
+                logconsole("[Resume] " + task->url + " at " + std::to_string(t->offset) + " bytes");
+            else
+                logconsole("[Download] " + task->url);
+        }
+        curl_easy_setopt(t->curl, CURLOPT_URL, task->url.c_str());
+        curl_easy_setopt(t->curl, CURLOPT_WRITEFUNCTION, curlcallback);
+        curl_easy_setopt(t->curl, CURLOPT_WRITEDATA, t.get());
+        curl_easy_setopt(t->curl, CURLOPT_PRIVATE, t.get());
+        // Prefer waiting for a multiplexed HTTP/2 stream over opening another connection.
+        //
+        curl_easy_setopt(t->curl, CURLOPT_PIPEWAIT, 1L);
+        if (t->offset > 0)
+            curl_easy_setopt(t->curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(t->offset));
+        curl_multi_add_handle(multi, t->curl);
+        inflight.push_back(std::move(t));
+    };
+
+    while (next < pending.size() || !inflight.empty())
+    {
+        // Keep the pipeline full.
+        //
+        while (next < pending.size() && inflight.size() < static_cast<size_t>(maxconnections))
+            addtransfer();
+        if (inflight.empty())
+            continue;
+        int stillrunning = 0;
+        CURLMcode mc = curl_multi_perform(multi, &stillrunning);
+        if (mc != CURLM_OK)
+        {
+            if (logconsole)
+                logconsole(std::string("[Error] CURL multi failed: ") + curl_multi_strerror(mc));
+            break;
+        }
+        // Collect finished transfers right away, the last ones often complete inside perform.
+        //
+        size_t finished = 0;
+        int msgsleft = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &msgsleft))
+        {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            finished++;
+            transfer* t = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &t);
+            CURLcode result = msg->data.result;
+            curl_multi_remove_handle(multi, t->curl);
+            if (result == CURLE_OK)
+            {
+                long connects = 0;
+                curl_off_t bytes = 0;
+                curl_off_t time = 0;
+                curl_easy_getinfo(t->curl, CURLINFO_NUM_CONNECTS, &connects);
+                curl_easy_getinfo(t->curl, CURLINFO_SIZE_DOWNLOAD_T, &bytes);
+                curl_easy_getinfo(t->curl, CURLINFO_TOTAL_TIME_T, &time);
+                completed++;
+                newconnections += connects;
+                totalbytes += bytes;
+                totaltime += time;
+            }
+            long code = 0;
+            curl_easy_getinfo(t->curl, CURLINFO_RESPONSE_CODE, &code);
+            context.release(t->curl);
+            // A server that answers a resumed request with anything but 206 doesn't honor the
+            // range (curl reports a 200 as CURLE_RANGE_ERROR), so start the part over right away.
+            //
+            bool rangeignored = t->offset > 0 && (result == CURLE_RANGE_ERROR || (code != 0 && code != 206));
+            if (rangeignored && restarted.insert(t->task).second)
+            {
+                t->file.close();
+                fs::remove(t->partpath);
+                if (logconsole && !quiet)
+                    logconsole("[Restart] " + t->task->url + " (server did not resume at " + std::to_string(t->offset) + " bytes)");
+                pending.push_back(t->task);
+            }
+            else if (result != CURLE_OK)
+            {
+                t->file.close();
+                // Keep the part for the next resume unless the server rejected its range.
+                //
+                if (code == 416)
+                    fs::remove(t->partpath);
+                failed++;
+                if (logconsole)
+                    logconsole(std::string("[Error] Downloading failed: ") + curl_easy_strerror(result) + " (" + t->task->url + ")");
+            }
+            else if (!finishtransfer(*t, logconsole))
+            {
+                failed++;
+            }
+            else
+            {
+                placed++;
+                if (oncomplete)
+                    oncomplete(*t->task);
+            }
+            for (auto it = inflight.begin(); it != inflight.end(); ++it)
+            {
+                if (it->get() == t)
+                {
+                    inflight.erase(it);
+                    break;
+                }
+            }
+        }
+        // Only wait while transfers are running and no freed slot can take a pending task,
+        // and no longer than curl's own next timeout.
+        //
+        if (stillrunning > 0 && (finished == 0 || next >= pending.size()))
+        {
+            long timeout = -1;
+            curl_multi_timeout(multi, &timeout);
+            if (timeout < 0 || timeout > 1000)
+                timeout = 1000;
+            mc = curl_multi_poll(multi, nullptr, 0, static_cast<int>(timeout), nullptr);
+            if (mc != CURLM_OK)
+            {
+                if (logconsole)
+                    logconsole(std::string("[Error] CURL multi failed: ") + curl_multi_strerror(mc));
+                break;
+            }
+        }
+    }
+    // Abort whatever is still attached when the loop was left early, the parts stay for a resume.
+    //
+    for (auto& t : inflight)
+    {
+        curl_multi_remove_handle(multi, t->curl);
+        context.release(t->curl);
+        t->file.close();
+        failed++;
+    }
+    // Report per-file latency and how many transfers had to open a new connection.
+    //
+    if (completed > 0 && logconsole)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - batchstart).count();
+        logconsole("[Download] " + std::to_string(completed) + " files, "
+            + std::to_string(totalbytes / 1024) + " KB in " + std::to_string(elapsed) + " ms (avg "
+            + std::to_string(totaltime / 1000 / static_cast<curl_off_t>(completed)) + " ms/file, "
+            + std::to_string(newconnections) + " new connections)");
+    }
+    return failed;
+}
@@ -0,0 +1,185 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/gchistory.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+// Sessions kept in the history, and how many of the newest ones the recommendation looks at.
+//
+static const size_t maxsessions = 10;
+static const size_t recentsessions = 5;
+
+gchistory::gchistory(const std::string& path)
+    :path(path)
+{
+    load();
+}
+
+const std::vector<gcsession>& gchistory::sessions() const
+{
+    return entries;
+}
+
+void gchistory::load()
+{
+    std::ifstream f(path);
+    if (!f)
+        return;
+    json history;
+    try {
+        f >> history;
+    } catch (const std::exception&) {
+        return;
+    }
+    if (!history.is_array())
+        return;
+    for (const auto& entry : history)
+    {
+        if (!entry.is_object())
+            continue;
+        gcsession session;
+        session.time = entry.value("time", int64_t(0));
+        session.heapmb = entry.value("heap", uint64_t(0));
+        session.peaklivemb = entry.value("peaklive", uint64_t(0));
+        session.pauses = entry.value("pauses", uint64_t(0));
+        session.totalpausems = entry.value("totalpause", 0.0);
+        session.maxpausems = entry.value("maxpause", 0.0);
+        entries.push_back(session);
+    }
+}
+
+void gchistory::save() const
+{
+    json history = json::array();
+    for (const auto& session : entries)
+    {
+        history.push_back({
+            { "time", session.time },
+            { "heap", session.heapmb },
+            { "peaklive", session.peaklivemb },
+            { "pauses", session.pauses },
+            { "totalpause", session.totalpausems },
+            { "maxpause", session.maxpausems }
+        });
+    }
+    std::string partpath = path + ".part";
+    {
+        std::ofstream f(partpath, std::ios::trunc);
+        if (!f)
+            return;
+        f << history.dump(1);
+    }
+    std::error_code ec;
+    fs::rename(partpath, path, ec);
+}
+
+void gchistory::add(const gcsession& session)
+{
+    entries.push_back(session);
+    if (entries.size() > maxsessions)
+        entries.erase(entries.begin(), entries.end() - maxsessions);
+    save();
+}
+
+// This function sizes the heap from the largest live set of the recent sessions: half again
+// as much room for the collector to work in plus a fixed margin, rounded up to 512M.
+//
+uint64_t gchistory::recommendedheapmb() const
+{
+    uint64_t peak = 0;
+    size_t first = entries.size() > recentsessions ? entries.size() - recentsessions : 0;
+    for (size_t i = first; i < entries.size(); i++)
+        peak = std::max(peak, entries[i].peaklivemb);
+    if (peak == 0)
+        return 0;
+    uint64_t heap = peak + peak / 2 + 256;
+    heap = (heap + 511) / 512 * 512;
+    return std::max<uint64_t>(heap, 1024);
+}
+
+std::string gchistory::summary() const
+{
+    if (entries.empty())
+        return "no GC history yet";
+    uint64_t peak = 0;
+    double maxpause = 0;
+    for (const auto& session : entries)
+    {
+        peak = std::max(peak, session.peaklivemb);
+        maxpause = std::max(maxpause, session.maxpausems);
+    }
+    char buffer[160];
+    snprintf(buffer, sizeof(buffer), "%zu sessions, peak live %lluM, max pause %.1f ms, next heap %lluM",
+        entries.size(), static_cast<unsigned long long>(peak), maxpause,
+        static_cast<unsigned long long>(recommendedheapmb()));
+    return buffer;
+}
+
+// Reads a size like "812M" at text, returns megabytes or -1 when there is no unit.
+//
+static double parsesize(const char* text)
+{
+    char* end = nullptr;
+    double value = std::strtod(text, &end);
+    if (end == text)
+        return -1;
+    switch (*end)
+    {
+    case 'B': return value / (1024.0 * 1024.0);
+    case 'K': return value / 1024.0;
+    case 'M': return value;
+    case 'G': return value * 1024.0;
+    default: return -1;
+    }
+}
+
+// This function pulls the heap after each collection out of the [gc] lines, e.g.
+//   [gc] GC(12) Pause Young (Normal) (G1 Evacuation Pause) 120M->40M(256M) 3.456ms
+//   [gc] GC(4) Major Collection (Proactive) 1234M(15%)->456M(6%) 0.123s
+// and every pause out of lines like the one above and
+//   [gc,phases] GC(4) y: Pause Mark Start 0.012ms
+//
+gcsession gchistory::parselog(const std::string& logpath)
+{
+    gcsession session;
+    std::ifstream f(logpath);
+    if (!f)
+        return session;
+    double peaklive = 0;
+    std::string line;
+    while (std::getline(f, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        bool gcline = line.rfind("[gc]", 0) == 0 || line.rfind("[gc ", 0) == 0;
+        bool phaseline = line.rfind("[gc,phases", 0) == 0;
+        if (!gcline && !phaseline)
+            continue;
+        size_t arrow = gcline ? line.find("->") : std::string::npos;
+        if (arrow != std::string::npos)
+        {
+            double after = parsesize(line.c_str() + arrow + 2);
+            if (after > peaklive)
+                peaklive = after;
+        }
+        if (line.find("Pause ") == std::string::npos || line.size() < 3 || line.compare(line.size() - 2, 2, "ms") != 0)
+            continue;
+        size_t space = line.rfind(' ');
+        double pause = std::strtod(line.c_str() + space + 1, nullptr);
+        session.pauses++;
+        session.totalpausems += pause;
+        session.maxpausems = std::max(session.maxpausems, pause);
+    }
+    session.peaklivemb = static_cast<uint64_t>(peaklive + 0.5);
+    return session;
+}
@@ -11,6 +11,14 @@ std::atomic<bool> minecraftrunning = false;
 namespace fs = std::filesystem;
 using json = nlohmann::json;
 
+// Separator between classpath entries, as the java launcher of this platform expects it.
+//
+#ifdef _WIN32
+static const char* const classpathseparator = ";";
+#else
+static const char* const classpathseparator = ":";
+#endif
+
 // Used when not passing a custom logger.
 //
 void launcher::logger(const std::string& msg)
@@ -25,11 +33,16 @@ launcher::launcher
     const std::string& versionid,
     std::function<void(const std::string&)> logger
 )
-    :versionid(versionid)
+    :versionid(versionid), store((fs::path(".minecraft") / "libraries").make_preferred().string()), host(platform::current())
 {
     jsonpath = (fs::path(".minecraft") / "versions" / versionid / (versionid + ".json")).make_preferred().string();
     libspath = (fs::path(".minecraft") / "versions" / versionid / "libraries").make_preferred().string();
     nativespath = (fs::path(".minecraft") / "natives" / versionid).make_preferred().string();
+    assetspath = (fs::path(".minecraft") / "assets").make_preferred().string();
+    planpath = (fs::path(".minecraft") / "versions" / versionid / "launchplan.json").make_preferred().string();
+    cdspath = (fs::path(".minecraft") / "versions" / versionid / "appcds.jsa").make_preferred().string();
+    gclogpath = (fs::path(".minecraft") / "versions" / versionid / "gc.log").make_preferred().string();
+    gchistorypath = (fs::path(".minecraft") / "versions" / versionid / "gchistory.json").make_preferred().string();
 
     if (logger)
         logconsole = std::move(logger);
@@ -37,62 +50,507 @@ launcher::launcher
         logconsole = launcher::logger;
 }
 
-// Called by curl every time bytes are downloaded.
+// Sets how many library downloads run at the same time.
 //
-static size_t curlcallback(void* ptr, size_t size, size_t nmemb, void* userdata)
+void launcher::setmaxdownloads(long count)
 {
-    std::ofstream* stream = reinterpret_cast<std::ofstream*>(userdata);
-    size_t written = size * nmemb;
-    stream->write(reinterpret_cast<char*>(ptr), written);
-    return written;
+    maxdownloads = count > 0 ? count : 1;
 }
 
-// This function downloads missing libraries.
+// Makes the next setup hash every existing library instead of only checking its size.
 //
-void launcher::downloadfiles(const std::string& url, const std::string& outputpath)
+void launcher::setverifyfiles(bool enabled)
 {
-    // Ensure folder exists.
+    verifyfiles = enabled;
+}
+
+// Turns the AppCDS class archive of each version on or off.
+//
+void launcher::setappcds(bool enabled)
+{
+    appcds = enabled;
+}
+
+// Turns GC logging on or off, and with it heap sizes learned from earlier sessions.
+//
+void launcher::setgclogging(bool enabled)
+{
+    gclogging = enabled;
+}
+
+// This function downloads missing libraries as one batch and returns how many failed.
+//
+size_t launcher::downloadfiles(const std::vector<downloadtask>& tasks)
+{
+    downloader engine(maxdownloads, logconsole);
+    engine.setverify(verifyfiles);
+    size_t failed = engine.run(tasks);
+    if (failed > 0 && logconsole)
+        logconsole("[Error] " + std::to_string(failed) + " of " + std::to_string(tasks.size()) + " downloads failed.");
+    return failed;
+}
+
+// This function downloads a single file the rest of the setup can't do without.
+//
+void launcher::downloadfile(const downloadtask& task)
+{
+    if (downloadfiles({ task }) > 0)
+        throw std::runtime_error("Failed to download " + task.url);
+}
+
+// This function looks the version up in Mojang's version manifest when its JSON isn't installed yet.
+//
+void launcher::downloadmanifest()
+{
+    if (fs::exists(jsonpath))
+        return;
+    std::string manifestpath = (fs::path(".minecraft") / "versions" / "version_manifest_v2.json").make_preferred().string();
+    // Look for the version in the cached manifest first, refresh it when the version is unknown.
+    //
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        if (attempt > 0 || !fs::exists(manifestpath))
+        {
+            // The manifest has no sha1 or size to check a leftover part against, never resume it.
+            //
+            fs::remove(manifestpath);
+            fs::remove(manifestpath + ".part");
+            downloadfile({ "https://piston-meta.mojang.com/mc/game/version_manifest_v2.json", manifestpath, "", 0 });
+        }
+        json manifest;
+        {
+            std::ifstream f(manifestpath);
+            if (!f)
+                throw std::runtime_error("Failed to open version manifest: " + manifestpath);
+            try {
+                f >> manifest;
+            } catch (const std::exception&) {
+                // A truncated or corrupt cached copy is downloaded again.
+                //
+                if (attempt > 0)
+                    throw std::runtime_error("Failed to parse version manifest: " + manifestpath);
+                continue;
+            }
+        }
+        for (const auto& entry : manifest.value("versions", json::array()))
+        {
+            if (entry.value("id", "") == versionid)
+            {
+                versionurl = entry.value("url", "");
+                versionsha1 = entry.value("sha1", "");
+                return;
+            }
+        }
+    }
+    throw std::runtime_error("Unknown version: " + versionid);
+}
+
+// This function downloads the version JSON if needed and parses it once for all other steps.
+//
+void launcher::downloadversionjson()
+{
+    if (!versionurl.empty())
+        downloadfile({ versionurl, jsonpath, versionsha1, 0 });
+    // Drop the previous manifest first, on Windows its cache can't be replaced while it is mapped.
     //
-    fs::create_directories(fs::path(outputpath).parent_path());
-    if (fs::exists(outputpath))
+    manifest = versionmanifest();
+    manifest = versionmanifest::load(jsonpath);
+}
+
+// This function downloads the game jar itself.
+//
+void launcher::downloadclient()
+{
+    const manifestartifact& client = manifest.client;
+    if (client.url.length == 0)
     {
         if (logconsole)
-            logconsole("[Skip] " + outputpath);
+            logconsole("[Warn] Version JSON has no client download.");
         return;
     }
-    if (logconsole)
-        logconsole("[Download] " + url);
-    // Open output file.
+    std::string jarpath = (fs::path(".minecraft") / "versions" / versionid / (versionid + ".jar")).make_preferred().string();
+    downloadfile({ manifest.string(client.url), jarpath, manifest.string(client.sha1), client.size });
+}
+
+// Returns the classifier of a maven name like "group:artifact:version:classifier", or "".
+//
+static std::string_view libraryclassifier(std::string_view name)
+{
+    size_t first = name.find(':');
+    size_t second = first == std::string::npos ? first : name.find(':', first + 1);
+    size_t third = second == std::string::npos ? second : name.find(':', second + 1);
+    if (third == std::string::npos)
+        return std::string_view();
+    return name.substr(third + 1);
+}
+
+// Splits a maven name into its "group:artifact[:classifier]" key and its version.
+//
+static void splitlibraryname(std::string_view name, std::string& key, std::string& version)
+{
+    size_t first = name.find(':');
+    size_t second = first == std::string::npos ? first : name.find(':', first + 1);
+    if (second == std::string::npos)
+    {
+        key = name;
+        version.clear();
+        return;
+    }
+    size_t third = name.find(':', second + 1);
+    key = name.substr(0, second);
+    version = name.substr(second + 1, third == std::string::npos ? std::string::npos : third - second - 1);
+    if (third != std::string::npos)
+        key += name.substr(third);
+}
+
+// Compares two maven versions piece by piece, numbers numerically. Returns <0, 0 or >0.
+//
+static int compareversions(const std::string& a, const std::string& b)
+{
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size())
+    {
+        auto isseparator = [](char c) { return c == '.' || c == '-' || c == '_' || c == '+'; };
+        size_t iend = i, jend = j;
+        while (iend < a.size() && !isseparator(a[iend])) iend++;
+        while (jend < b.size() && !isseparator(b[jend])) jend++;
+        std::string pa = a.substr(i, iend - i);
+        std::string pb = b.substr(j, jend - j);
+        bool na = !pa.empty() && pa.find_first_not_of("0123456789") == std::string::npos;
+        bool nb = !pb.empty() && pb.find_first_not_of("0123456789") == std::string::npos;
+        int result = 0;
+        if (na && nb)
+        {
+            // Compare without converting, so long numbers can't overflow.
+            //
+            pa.erase(0, (std::min)(pa.find_first_not_of('0'), pa.size()));
+            pb.erase(0, (std::min)(pb.find_first_not_of('0'), pb.size()));
+            result = pa.size() != pb.size() ? (pa.size() < pb.size() ? -1 : 1) : pa.compare(pb);
+        }
+        else
+        {
+            result = pa.compare(pb);
+        }
+        if (result != 0)
+            return result < 0 ? -1 : 1;
+        i = iend < a.size() ? iend + 1 : iend;
+        j = jend < b.size() ? jend + 1 : jend;
+    }
+    return 0;
+}
+
+// This function downloads the libraries this machine needs into the shared store in one concurrent batch.
+// Natives jars are extracted on a worker thread as soon as each one is in place,
+// so extraction overlaps with the remaining downloads.
+//
+void launcher::downloadlibraries()
+{
+    std::vector<downloadtask> tasks;
+    std::unordered_set<std::string> nativejars;
+    bool storechanged = false;
+    libraries.clear();
+    // Queue one artifact, natives-only jars stay off the classpath.
+    //
+    std::vector<classpathentry> candidates;
+    auto addartifact = [&](const manifestartifact& artifact, std::string_view name, bool classpath, bool native)
+    {
+        if (artifact.url.length == 0 || artifact.path.length == 0)
+        {
+            if (logconsole)
+                logconsole("[Warn] Skip library (missing URL or path).");
+            return;
+        }
+        std::string apath = manifest.string(artifact.path);
+        std::string sha1 = manifest.string(artifact.sha1);
+        std::string targetpath = store.resolve(apath, sha1);
+        if (store.adopt((fs::path(libspath) / fs::path(apath).make_preferred()).string(), targetpath))
+            storechanged = true;
+        if (classpath)
+        {
+            classpathentry entry;
+            splitlibraryname(name, entry.key, entry.version);
+            entry.path = fs::absolute(targetpath).string();
+            candidates.push_back(std::move(entry));
+        }
+        if (native)
+            nativejars.insert(targetpath);
+        tasks.push_back({ manifest.string(artifact.url), targetpath, sha1, artifact.size });
+    };
+    std::string nativesclassifier = host.nativesclassifier();
+    rulepatterns patterns(manifest);
+    for (const auto& lib : manifest.libraries)
+    {
+        // Libraries meant for another OS, architecture or feature set.
+        //
+        if (!rulesallow(manifest, patterns, lib.firstrule, lib.rulecount, host)) continue;
+        // Since 1.19 natives are separate libraries with the platform in their classifier.
+        //
+        std::string_view name = manifest.str(lib.name);
+        std::string_view classifier = libraryclassifier(name);
+        bool native = classifier.rfind("natives-", 0) == 0;
+        if (native && classifier != nativesclassifier) continue;
+        // Older versions list natives per OS as classifier downloads of the library itself.
+        //
+        for (uint32_t i = 0; i < lib.nativecount; i++)
+        {
+            const manifestnative& entry = manifest.natives[lib.firstnative + i];
+            if (manifest.str(entry.os) != host.os)
+                continue;
+            std::string key = manifest.string(entry.classifier);
+            size_t archpos = key.find("${arch}");
+            if (archpos != std::string::npos)
+                key.replace(archpos, 7, host.arch == "x86" ? "32" : "64");
+            for (uint32_t c = 0; c < lib.classifiercount; c++)
+            {
+                const manifestclassifier& download = manifest.classifiers[lib.firstclassifier + c];
+                if (manifest.str(download.key) == key)
+                    addartifact(download.artifact, name, false, true);
+            }
+        }
+        if (!lib.hasartifact) continue;
+        addartifact(lib.artifact, name, true, native);
+    }
+    // Keep only the newest version of every group:artifact, at the place it first appeared,
+    // and don't download the versions that lost.
+    //
+    std::unordered_map<std::string, size_t> newest;
+    for (const auto& entry : candidates)
+    {
+        auto it = newest.find(entry.key);
+        if (it == newest.end())
+        {
+            newest[entry.key] = libraries.size();
+            libraries.push_back(entry);
+        }
+        else if (compareversions(entry.version, libraries[it->second].version) > 0)
+        {
+            if (logconsole)
+                logconsole("[Warn] " + entry.key + ": using " + entry.version + " over " + libraries[it->second].version);
+            libraries[it->second] = entry;
+        }
+    }
+    std::unordered_set<std::string> kept;
+    for (const auto& entry : libraries)
+        kept.insert(entry.path);
+    std::unordered_set<std::string> dropped;
+    for (const auto& entry : candidates)
+    {
+        if (kept.count(entry.path) == 0)
+            dropped.insert(entry.path);
+    }
+    if (!dropped.empty())
+    {
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [&](const downloadtask& task)
+        {
+            return nativejars.count(task.outputpath) == 0 && dropped.count(fs::absolute(task.outputpath).string()) > 0;
+        }), tasks.end());
+    }
+    // Extraction worker, fed by the downloader.
+    //
+    std::unordered_set<std::string> extractedjars;
+    size_t extractfailures = 0;
+    loadnativesmanifest();
+    std::mutex queuemutex;
+    std::condition_variable queuecv;
+    std::deque<std::string> queue;
+    bool downloadsdone = false;
+    std::thread extractor([&]()
+    {
+        std::unique_lock<std::mutex> lock(queuemutex);
+        while (true)
+        {
+            queuecv.wait(lock, [&]() { return !queue.empty() || downloadsdone; });
+            if (queue.empty())
+                return;
+            std::string jar = queue.front();
+            queue.pop_front();
+            lock.unlock();
+            try {
+                std::string jarpath = fs::absolute(jar).make_preferred().string();
+                extractedjars.insert(jarpath);
+                extractnatives(jarpath);
+            } catch (const std::exception& e) {
+                if (logconsole)
+                    logconsole(std::string("[Error] Extracting natives failed: ") + e.what());
+                extractfailures++;
+            }
+            lock.lock();
+        }
+    });
+    downloader engine(maxdownloads, logconsole);
+    engine.setverify(verifyfiles);
+    engine.setoncomplete([&](const downloadtask& task)
+    {
+        if (nativejars.count(task.outputpath) == 0)
+            return;
+        std::lock_guard<std::mutex> lock(queuemutex);
+        queue.push_back(task.outputpath);
+        queuecv.notify_one();
+    });
+    size_t failed = 0;
+    std::exception_ptr error;
+    try {
+        failed = engine.run(tasks);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // Let the worker finish whatever is still queued.
+    //
+    {
+        std::lock_guard<std::mutex> lock(queuemutex);
+        downloadsdone = true;
+    }
+    queuecv.notify_one();
+    extractor.join();
+    savenativesmanifest(extractedjars);
+    if (storechanged || engine.placedfiles() > 0)
+        store.bumpgeneration();
+    if (error)
+        std::rethrow_exception(error);
+    // Fail the step so the setup is not taken as complete and the next launch retries it.
     //
-    std::ofstream file(outputpath, std::ios::binary);
-    if (!file)
-        throw std::runtime_error("Failed to open output file: " + outputpath);
-    // CURL
+    if (failed > 0)
+        throw std::runtime_error(std::to_string(failed) + " of " + std::to_string(tasks.size()) + " downloads failed.");
+    if (extractfailures > 0)
+        throw std::runtime_error("Extracting natives failed for " + std::to_string(extractfailures) + " jars.");
+}
+
+// This function downloads the asset index of the version.
+//
+void launcher::downloadassetindex()
+{
+    const manifestartifact& index = manifest.assetindex;
+    if (index.url.length == 0 && manifest.assetindexid.length == 0)
+    {
+        if (logconsole)
+            logconsole("[Warn] Version JSON has no assetIndex, skipping assets.");
+        return;
+    }
+    assetindexid = manifest.assetindexid.length > 0 ? manifest.string(manifest.assetindexid) : versionid;
+    assetindexpath = (fs::path(assetspath) / "indexes" / (assetindexid + ".json")).make_preferred().string();
+    if (index.url.length > 0)
+        downloadfile({ manifest.string(index.url), assetindexpath, manifest.string(index.sha1), index.size });
+}
+
+// This function downloads every object the asset index lists.
+// Objects are stored by hash under assets/objects/<xx>/<hash>, shared by all versions.
+//
+void launcher::downloadassetobjects()
+{
+    if (assetindexpath.empty())
+        return;
+    assetmanifest index = assetmanifest::load(assetindexpath);
+    // Queue every object, the downloader skips the ones already present with the right size.
+    // Several names can share one object, those have the same hash ref and are queued once
+    // so two transfers never write the same file.
     //
-    CURL* curl = curl_easy_init();
-    if (!curl)
-        throw std::runtime_error("Failed to initialize curl.");
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlcallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &file);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    CURLcode result = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-    file.close();
-    if (result != CURLE_OK)
+    fs::path objectsdir = fs::path(assetspath) / "objects";
+    std::vector<downloadtask> tasks;
+    std::unordered_set<uint32_t> queued;
+    tasks.reserve(index.objects.size());
+    queued.reserve(index.objects.size());
+    for (const auto& object : index.objects)
     {
-        throw std::runtime_error(
-            std::string("CURL download failed: ") + curl_easy_strerror(result)
-        );
+        if (object.hash.length != 40 || !queued.insert(object.hash.offset).second)
+            continue;
+        std::string hash = index.string(object.hash);
+        std::string prefix = hash.substr(0, 2);
+        tasks.push_back({
+            "https://resources.download.minecraft.net/" + prefix + "/" + hash,
+            (objectsdir / prefix / hash).make_preferred().string(),
+            hash,
+            object.size
+        });
+    }
+    if (logconsole)
+        logconsole("[Assets] " + assetindexid + ": " + std::to_string(tasks.size()) + " objects");
+    downloader engine(maxassetdownloads, logconsole);
+    engine.setverify(verifyfiles);
+    engine.setquiet(true);
+    size_t failed = engine.run(tasks);
+    if (failed > 0)
+        throw std::runtime_error(std::to_string(failed) + " of " + std::to_string(tasks.size()) + " asset downloads failed.");
+}
+
+// This function loads the record of what was extracted into nativespath by earlier runs.
+//
+void launcher::loadnativesmanifest()
+{
+    nativesmanifest = json::object();
+    std::ifstream f((fs::path(nativespath) / "natives.json").string());
+    if (!f)
+        return;
+    try {
+        f >> nativesmanifest;
+    } catch (const std::exception&) {
+        nativesmanifest = json::object();
+    }
+    if (!nativesmanifest.is_object())
+        nativesmanifest = json::object();
+}
+
+// This function writes the extraction record, dropping jars this version no longer uses.
+//
+void launcher::savenativesmanifest(const std::unordered_set<std::string>& usedjars)
+{
+    for (auto it = nativesmanifest.begin(); it != nativesmanifest.end();)
+    {
+        if (usedjars.count(it.key()) == 0)
+            it = nativesmanifest.erase(it);
+        else
+            ++it;
+    }
+    fs::create_directories(nativespath);
+    fs::path manifestpath = fs::path(nativespath) / "natives.json";
+    fs::path partpath = manifestpath;
+    partpath += ".part";
+    {
+        std::ofstream f(partpath.string());
+        if (!f)
+            return;
+        f << nativesmanifest.dump();
     }
+    std::error_code ec;
+    fs::rename(partpath, manifestpath, ec);
 }
 
-// This function extracts natives (.dll) from the version jar.
+// This function extracts natives (.dll, .so or .dylib) from the version jar.
+// The jar's size and write time and the size and CRC of every extracted file are recorded
+// in natives.json, so an unchanged jar costs a few stat calls instead of a full extraction.
 //
 void launcher::extractnatives(const std::string& jarpath)
 {
+    std::error_code ec;
+    uint64_t jarsize = fs::file_size(jarpath, ec);
+    if (ec)
+        throw std::runtime_error("Failed to open jar: " + jarpath);
+    int64_t jartime = static_cast<int64_t>(fs::last_write_time(jarpath, ec).time_since_epoch().count());
+    // Check the record of the last extraction first.
+    //
+    json& record = nativesmanifest[jarpath];
+    if (record.is_object() && record.value("size", uint64_t(0)) == jarsize && record.value("mtime", int64_t(0)) == jartime)
+    {
+        bool intact = true;
+        for (const auto& file : record.value("files", json::array()))
+        {
+            fs::path outpath = fs::path(nativespath) / file.value("name", "");
+            if (fs::file_size(outpath, ec) != file.value("size", uint64_t(0)) || ec)
+            {
+                intact = false;
+                break;
+            }
+        }
+        if (intact)
+            return;
+    }
+    // Files the previous extraction wrote, by name, to skip entries that did not change.
+    //
+    std::unordered_map<std::string, std::pair<uint64_t, uint32_t>> previous;
+    if (record.is_object())
+    {
+        for (const auto& file : record.value("files", json::array()))
+            previous[file.value("name", "")] = { file.value("size", uint64_t(0)), file.value("crc", uint32_t(0)) };
+    }
     // Ensure folder exists.
     //
     fs::create_directories(nativespath);
@@ -104,36 +562,49 @@ void launcher::extractnatives(const std::string& jarpath)
 
     if (!zip)
         throw std::runtime_error("Failed to open jar: " + jarpath);
+    json files = json::array();
+    size_t skipped = 0;
     zip_int64_t numentries = zip_get_num_entries(zip, 0);
     for (zip_int64_t i = 0; i < numentries; ++i)
     {
-        const char* name = zip_get_name(zip, i, 0);
-        if (!name)
+        // Name, size and CRC all come from the central directory.
+        //
+        zip_stat_t st;
+        if (zip_stat_index(zip, i, 0, &st) != 0 || !st.name)
         {
             if (logconsole)
                 logconsole("[Warn] Invalid ZIP entry at index: " + std::to_string(i));
             continue;
         }
-        std::string entryname = name;
-        // Only extract DLL files.
+        std::string entryname = st.name;
+        // Only extract the native libraries of this OS.
         //
-        if (entryname.size() > 4 &&
-            entryname.substr(entryname.size() - 4) == ".dll")
+        if (host.isnativelibrary(entryname))
         {
-            std::string outpath = (fs::path(nativespath) / fs::path(entryname).filename()).string();
+            std::string filename = fs::path(entryname).filename().string();
+            std::string outpath = (fs::path(nativespath) / filename).string();
+            files.push_back({ { "name", filename }, { "size", st.size }, { "crc", st.crc } });
+            auto old = previous.find(filename);
+            if (old != previous.end() && old->second.first == st.size && old->second.second == st.crc
+                && fs::file_size(outpath, ec) == st.size && !ec)
+                continue;
             zip_file_t* zf = zip_fopen_index(zip, i, 0);
             if (!zf) 
             {
                 if (logconsole)
                     logconsole("[Error] Failed to open ZIP entry: " + entryname);
+                files.erase(files.end() - 1);
+                skipped++;
                 continue;
             }
             std::ofstream out(outpath, std::ios::binary);
             if (!out)
             {
                 if (logconsole)
-                    logconsole("[Error] Failed to create output DLL: " + outpath);
+                    logconsole("[Error] Failed to create output library: " + outpath);
+                files.erase(files.end() - 1);
                 zip_fclose(zf);
+                skipped++;
                 continue;
             }
             // Allocate a temporary buffer for reading.
@@ -151,23 +622,33 @@ void launcher::extractnatives(const std::string& jarpath)
     // Close jar.
     //
     zip_close(zip);
+    // Leave the record as it was so the next run extracts this jar again.
+    //
+    if (skipped > 0)
+        throw std::runtime_error(std::to_string(skipped) + " natives could not be extracted from " + jarpath);
+    record = { { "size", jarsize }, { "mtime", jartime }, { "files", files } };
     if (logconsole)
         logconsole("[Extract] " + fs::path(jarpath).filename().string());
 }
 
-// This function collects all jar files.
+// This function builds the classpath from the libraries resolved by downloadlibraries(),
+// in manifest order and with one version per artifact, without scanning any folder.
 //
 std::string launcher::getclasspath()
 {
     std::vector<std::string> jars;
-    // Collect all .jar files recursively in libspath.
-    //
-    for (auto& entry : fs::recursive_directory_iterator(libspath))
+    jars.reserve(libraries.size() + 1);
+    classpathcomplete = true;
+    for (const auto& entry : libraries)
     {
-        if (entry.is_regular_file() && entry.path().extension() == ".jar")
+        if (fs::exists(entry.path))
         {
-            jars.push_back(entry.path().string());
+            jars.push_back(entry.path);
+            continue;
         }
+        classpathcomplete = false;
+        if (logconsole)
+            logconsole("[Error] Missing library: " + entry.path);
     }
     // Main game JAR.
     //
@@ -178,259 +659,449 @@ std::string launcher::getclasspath()
     }
     else
     {
+        classpathcomplete = false;
         if (logconsole)
             logconsole("[Error] Missing version JAR: " + mainjar.string());
     }
-    // Build classpath string using ';' separator (Windows).
+    // Build classpath string using the platform's separator.
     //
     std::string classpath;
     for (size_t i = 0; i < jars.size(); i++)
     {
         classpath += jars[i];
         if (i + 1 < jars.size())
-            classpath += ";";
+            classpath += classpathseparator;
     }
     if (jars.empty()) {
         if (logconsole)
-            logconsole("[Error] No JARs found in libraries directory: " + libspath);
+            logconsole("[Error] No JARs found in library store: " + store.path());
     }
     return classpath;
 }
 
-// This function reads the version json and builds the launch command used to launch minecraft.
+// Classpaths longer than this are passed through an argument file, Windows
+// refuses command lines over 32767 characters.
+//
+static const size_t argfilethreshold = 8192;
+
+// This function writes "-cp <classpath>" to a java @argfile, unless the file already holds exactly that.
+// Inside quotes java treats backslashes as escapes, so they are doubled.
+//
+static bool writeargfile(const std::string& path, const std::string& classpath)
+{
+    std::string content = "-cp \"";
+    content.reserve(classpath.size() + 8);
+    for (char c : classpath)
+    {
+        if (c == '\\' || c == '"')
+            content += '\\';
+        content += c;
+    }
+    content += "\"\n";
+    {
+        std::ifstream f(path, std::ios::binary);
+        if (f)
+        {
+            std::string existing((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+            if (existing == content)
+                return true;
+        }
+    }
+    std::string partpath = path + ".part";
+    {
+        std::ofstream f(partpath, std::ios::binary | std::ios::trunc);
+        if (!f)
+            return false;
+        f << content;
+        if (!f)
+            return false;
+    }
+    std::error_code ec;
+    fs::rename(partpath, path, ec);
+    return !ec;
+}
+
+// Size and write time of a file, or "missing".
+//
+static std::string filestamp(const std::string& path)
+{
+    std::error_code ec;
+    uint64_t size = fs::file_size(path, ec);
+    if (ec)
+        return "missing";
+    auto time = fs::last_write_time(path, ec).time_since_epoch().count();
+    return std::to_string(size) + ":" + std::to_string(static_cast<int64_t>(time));
+}
+
+// Reads the release file next to a java runtime's bin folder, empty when there is none.
+//
+static std::string javarelease(const std::string& javapath)
+{
+    fs::path release = fs::path(javapath).parent_path().parent_path() / "release";
+    std::ifstream f(release.string(), std::ios::binary);
+    if (!f)
+        return "";
+    return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+}
+
+// Feature version of a runtime from its release file, e.g. 21 for JAVA_VERSION="21.0.7"
+// and 8 for "1.8.0_402". Returns 0 when it can't be told.
 //
-std::string launcher::buildlaunchcommand(const std::string& username)
+static int javamajor(const std::string& release)
 {
-    // Read version JSON.
+    size_t key = release.find("JAVA_VERSION=\"");
+    if (key == std::string::npos)
+        return 0;
+    const char* version = release.c_str() + key + 14;
+    int major = std::atoi(version);
+    if (major == 1 && std::strncmp(version, "1.", 2) == 0)
+        major = std::atoi(version + 2);
+    return major;
+}
+
+// This function adds the AppCDS options. The first launch records the classes the game
+// loads into a dynamic archive when the JVM exits, later launches map that archive instead
+// of loading and verifying those classes again. The archive is only valid for the classpath
+// and runtime it was recorded with, so both are hashed into appcds.key next to it.
+//
+void launcher::appcdsarguments(const std::string& javapath, std::vector<std::string>& argv)
+{
+    std::string release = javarelease(javapath);
+    // -XX:ArchiveClassesAtExit exists since JDK 13.
     //
-    std::ifstream file(jsonpath);
-    if (!file)
+    if (javamajor(release) < 13)
+        return;
+    sha1hash hash;
+    std::string identity = javapath + "\n" + filestamp(javapath) + "\n" + release + "\n" + classpath;
+    hash.update(identity.data(), identity.size());
+    std::string key = hash.hexdigest();
+    std::string keypath = cdspath + ".key";
+    std::string recorded;
     {
+        std::ifstream f(keypath);
+        if (f)
+            std::getline(f, recorded);
+    }
+    std::error_code ec;
+    fs::path archive = fs::absolute(cdspath, ec);
+    if (recorded == key && fs::exists(cdspath, ec))
+    {
+        argv.push_back("-XX:SharedArchiveFile=" + archive.string());
         if (logconsole)
-            logconsole("[Error] Failed to read version JSON: " + jsonpath);
-        return "";
+            logconsole("[Launch] Using AppCDS archive " + cdspath);
+        return;
     }
-    json versiondata;
-    file >> versiondata;
-    // Parse main class.
+    // Record a new archive, the old one belongs to another classpath or runtime.
     //
-    std::string mainclass = versiondata.contains("mainClass")
-        ? versiondata["mainClass"].get<std::string>()
-        : "";
+    fs::remove(cdspath, ec);
+    {
+        std::ofstream f(keypath, std::ios::trunc);
+        if (!f)
+            return;
+        f << key << "\n";
+    }
+    argv.push_back("-XX:ArchiveClassesAtExit=" + archive.string());
+    if (logconsole)
+        logconsole("[Launch] Recording AppCDS archive on exit: " + cdspath);
+}
+
+// This function builds the launch arguments (everything after java) from the parsed version JSON.
+//
+std::vector<std::string> launcher::buildlaunchcommand(const std::string& username, const std::string& javapath)
+{
+    // The version JSON was parsed by the setup, only read it here if that didn't happen.
+    //
+    if (!manifest.loaded())
+    {
+        try {
+            manifest = versionmanifest::load(jsonpath);
+        } catch (const std::exception& e) {
+            if (logconsole)
+                logconsole(std::string("[Error] Failed to read version JSON: ") + e.what());
+            return {};
+        }
+    }
+    std::string mainclass = manifest.string(manifest.mainclass);
     if (mainclass.empty())
     {
         if (logconsole)
             logconsole("[Error] mainClass missing in version JSON.");
-        return "";
+        return {};
     }
-    // Parse asset index.
-    //
-    std::string assetindex = versiondata.contains("assets")
-        ? versiondata["assets"].get<std::string>()
-        : versionid;
+    std::string assetindex = manifest.assets.length > 0 ? manifest.string(manifest.assets) : versionid;
     // Build classpath.
     //
-    std::string classpath = getclasspath();
+    classpath = getclasspath();
     // Build paths.
     //
     fs::path nativesdir = fs::absolute(nativespath);
     fs::path versiongamedir = fs::absolute(fs::path(".minecraft/versions") / versionid);
-    fs::path versionassetsdir = versiongamedir / "assets";
+    fs::path assetsdir = fs::absolute(assetspath);
     // Ensure directories exist.
     //
     fs::create_directories(versiongamedir);
-    fs::create_directories(versionassetsdir);
-    // Build Java command.
+    fs::create_directories(assetsdir);
+    // Values for the ${...} placeholders of the version's arguments.
     //
-    std::string cmd;
-    cmd += "-Xmx2G -Xms1G ";
-    cmd += "-Djava.library.path=\"" + nativesdir.string() + "\" ";
-    cmd += "-cp \"" + classpath + "\" ";
-    cmd += mainclass + " ";
-    cmd += "--username " + username + " ";
-    cmd += "--version " + versionid + " ";
-    cmd += "--gameDir \"" + versiongamedir.string() + "\" ";
-    cmd += "--assetsDir \"" + versionassetsdir.string() + "\" ";
-    cmd += "--assetIndex " + assetindex + " ";
-    cmd += "--uuid 00000000-0000-0000-0000-000000000000 ";
-    cmd += "--accessToken 0 ";
-    cmd += "--userType mojang";
-    return cmd;
-}
-
-// This function reads the version json and downloads libraries and natives using downloadfile() and extractnatives().
-//
-void launcher::setuplauncher()
-{
-    // Read and parse the version JSON.
+    argumentvalues values;
+    values.set(argumentvariable::auth_player_name, username);
+    values.set(argumentvariable::version_name, versionid);
+    values.set(argumentvariable::game_directory, versiongamedir.string());
+    values.set(argumentvariable::assets_root, assetsdir.string());
+    values.set(argumentvariable::game_assets, assetsdir.string());
+    values.set(argumentvariable::assets_index_name, assetindex);
+    values.set(argumentvariable::auth_uuid, "00000000-0000-0000-0000-000000000000");
+    values.set(argumentvariable::auth_access_token, "0");
+    values.set(argumentvariable::auth_session, "0");
+    values.set(argumentvariable::user_type, "mojang");
+    values.set(argumentvariable::user_properties, "{}");
+    values.set(argumentvariable::version_type, manifest.type.length > 0 ? manifest.string(manifest.type) : "release");
+    values.set(argumentvariable::natives_directory, nativesdir.string());
+    values.set(argumentvariable::library_directory, fs::absolute(store.path()).string());
+    values.set(argumentvariable::classpath, classpath);
+    values.set(argumentvariable::classpath_separator, classpathseparator);
+    values.set(argumentvariable::launcher_name, "cclauncher");
+    values.set(argumentvariable::launcher_version, "1.0");
+    values.set(argumentvariable::resolution_width, "854");
+    values.set(argumentvariable::resolution_height, "480");
+    // Build Java command: heap and GC settings, JVM arguments, main class, game arguments.
+    //
+    argumenttemplate arguments(manifest);
+    std::vector<std::string> argv = jvm.arguments;
+    arguments.expandjvm(values, host, argv);
+    if (appcds)
+        appcdsarguments(javapath, argv);
+    // Log collections and pauses, parsed after the game exits to size the next heap.
+    // The path is relative so its drive letter can't be mistaken for an -Xlog separator.
+    //
+    if (gclogging)
+        argv.push_back("-Xlog:gc,gc+phases:file=" + gclogpath + ":tags:filecount=0");
+    argv.push_back(mainclass);
+    arguments.expandgame(values, host, argv);
+    // Move a long classpath into an @argfile next to the version.
     //
-    json j;
+    if (classpath.size() > argfilethreshold)
     {
-        std::ifstream f(jsonpath);
-        if (!f)
+        for (size_t i = 0; i + 1 < argv.size(); i++)
         {
-            if (logconsole)
-                logconsole("[Error] Failed to open JSON: " + jsonpath);
-            return;
+            if ((argv[i] != "-cp" && argv[i] != "-classpath") || argv[i + 1] != classpath)
+                continue;
+            std::string argfile = (versiongamedir / "classpath.args").string();
+            if (!writeargfile(argfile, classpath))
+            {
+                if (logconsole)
+                    logconsole("[Warn] Failed to write " + argfile + ", passing the classpath directly.");
+                break;
+            }
+            argv[i] = "@" + argfile;
+            argv.erase(argv.begin() + i + 1);
+            break;
         }
-        f >> j;
     }
-    // Check for libraries array.
-    //
-    if (!j.contains("libraries") || !j["libraries"].is_array()) {
-        if (logconsole)
-            logconsole("[Error] Version JSON missing 'libraries' array.");
-        return;
+    return argv;
+}
+
+// This function installs everything the version needs, starting from nothing but its id.
+// The steps form a graph: each one starts as soon as the steps it needs have finished,
+// so libraries, the client jar and assets download side by side.
+//
+bool launcher::setuplauncher()
+{
+    taskgraph graph(logconsole);
+    auto manifest = graph.add("Version manifest", [this]() { downloadmanifest(); });
+    auto version = graph.add("Version JSON", [this]() { downloadversionjson(); }, { manifest });
+    graph.add("Client jar", [this]() { downloadclient(); }, { version });
+    graph.add("Libraries and natives", [this]() { downloadlibraries(); }, { version });
+    auto index = graph.add("Asset index", [this]() { downloadassetindex(); }, { version });
+    graph.add("Asset objects", [this]() { downloadassetobjects(); }, { index });
+    if (graph.run(4))
+        return true;
+    if (logconsole)
+        logconsole("[Warn] Setup finished with errors.");
+    return false;
+}
+
+// This function sums up everything a launch plan depends on.
+// Returns an empty string when the version isn't installed yet.
+//
+std::string launcher::launchfingerprint(const std::string& username, const std::string& javapath)
+{
+    std::string jsonhash = sha1hash::file(jsonpath);
+    if (jsonhash.empty())
+        return "";
+    std::string mainjar = (fs::path(".minecraft") / "versions" / versionid / (versionid + ".jar")).make_preferred().string();
+    std::string jvmkey;
+    for (const auto& argument : jvm.arguments)
+        jvmkey += argument + " ";
+    return "plan=6"
+        ";json=" + jsonhash +
+        ";store=" + std::to_string(store.generation()) +
+        ";client=" + filestamp(mainjar) +
+        ";java=" + javapath + ":" + filestamp(javapath) +
+        ";natives=" + filestamp((fs::path(nativespath) / "natives.json").string()) +
+        ";appcds=" + (appcds ? filestamp(cdspath) : "off") +
+        ";jvm=" + jvmkey +
+        ";gclog=" + (gclogging ? "on" : "off") +
+        ";user=" + username;
+}
+
+// This function loads the cached launch plan when it was made from the same inputs.
+//
+bool launcher::loadlaunchplan(const std::string& fingerprint, std::vector<std::string>& argv)
+{
+    if (fingerprint.empty())
+        return false;
+    std::ifstream f(planpath);
+    if (!f)
+        return false;
+    json plan;
+    try {
+        f >> plan;
+    } catch (const std::exception&) {
+        return false;
     }
-    // Download normal libraries
-    //
-    for (const auto& lib : j["libraries"])
+    if (plan.value("fingerprint", "") != fingerprint || !plan.contains("argv") || !plan["argv"].is_array())
+        return false;
+    argv.clear();
+    for (const auto& argument : plan["argv"])
     {
-        if (!lib.contains("downloads")) continue;
-        if (!lib["downloads"].contains("artifact")) continue;
-        const auto& artifact = lib["downloads"]["artifact"];
-        std::string url = artifact.value("url", "");
-        std::string apath = artifact.value("path", "");
-        if (url.empty() || apath.empty())
-        {
-            if (logconsole)
-                logconsole("[Warn] Skip library (missing URL or path).");
-            continue;
-        }
-        fs::path targetpath = fs::path(libspath) / fs::path(apath).make_preferred();
-        try {
-            downloadfiles(url, targetpath.string());
-        } catch (const std::exception& e) {
-            if (logconsole)
-                logconsole(std::string("[Error] Downloading failed: ") + e.what());
-        }
+        if (!argument.is_string())
+            return false;
+        argv.push_back(argument.get<std::string>());
+        // The plan is useless without the argument files it points at.
+        //
+        if (argv.back().size() > 1 && argv.back()[0] == '@' && !fs::exists(argv.back().substr(1)))
+            return false;
     }
-    // Extract native JARs.
-    //
-    for (const auto& lib : j["libraries"])
+    classpath = plan.value("classpath", "");
+    return !argv.empty();
+}
+
+// This function stores the launch command together with the inputs it was built from.
+//
+void launcher::savelaunchplan(const std::string& fingerprint, const std::vector<std::string>& argv)
+{
+    if (fingerprint.empty())
+        return;
+    json plan = { { "fingerprint", fingerprint }, { "argv", argv }, { "classpath", classpath } };
+    std::string partpath = planpath + ".part";
     {
-        if (!lib.contains("name")) continue;
-        std::string name = lib["name"];
-        if (name.find("natives-windows") != std::string::npos)
-        {
-            if (!lib.contains("downloads")) continue;
-            if (!lib["downloads"].contains("artifact")) continue;
-            const auto& artifact = lib["downloads"]["artifact"];
-            std::string apath = artifact.value("path", "");
-            if (apath.empty()) continue;
-            fs::path jar = fs::absolute(fs::path(libspath) / fs::path(apath)).make_preferred();
-            if (fs::exists(jar))
-            {
-                extractnatives(jar.string());
-            }
-        }
+        std::ofstream f(partpath);
+        if (!f)
+            return;
+        f << plan.dump();
     }
+    std::error_code ec;
+    fs::rename(partpath, planpath, ec);
 }
 
 // This function runs setuplauncher(), builds the final java command and starts minecraft.
+// Returns false when the game could not be started.
 //
-void launcher::launchprocess(const std::string& username)
+bool launcher::launchprocess(const std::string& username)
 {
-    // Setup launcher and launch command.
+#ifdef _WIN32
+    std::string javapath = (fs::path(".minecraft") / "java" / "bin" / "java.exe").make_preferred().string();
+#else
+    std::string javapath = (fs::path(".minecraft") / "java" / "bin" / "java").string();
+#endif
+    // Heap and GC for this machine, part of the launch plan so a different choice rebuilds it.
+    //
+    hostresources resources = hostresources::current();
+    uint64_t learnedheap = gclogging ? gchistory(gchistorypath).recommendedheapmb() : 0;
+    jvm = choosejvmsettings(resources, javamajor(javarelease(javapath)),
+        (fs::path(".minecraft") / "versions" / versionid / "jvm.json").make_preferred().string(), learnedheap);
+    if (logconsole)
+        logconsole("[JVM] " + jvm.summary() + " (" + std::to_string(resources.totalmb) + "M RAM, "
+            + std::to_string(resources.availablemb) + "M free, " + std::to_string(resources.cores) + " cores)");
+    // Use the cached launch plan when nothing it was built from changed,
+    // otherwise run the setup and build the launch command from scratch.
     //
-    setuplauncher();
-    std::string args = buildlaunchcommand(username);
-    if (args.empty()) {
+    auto planstart = std::chrono::steady_clock::now();
+    std::vector<std::string> argv;
+    if (loadlaunchplan(launchfingerprint(username, javapath), argv))
+    {
+        if (logconsole)
+            logconsole("[Launch] Using cached launch plan ("
+                + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - planstart).count()) + " ms)");
+    }
+    else
+    {
+        bool setupok = setuplauncher();
+        argv = buildlaunchcommand(username, javapath);
+        if (setupok && classpathcomplete && !argv.empty())
+            savelaunchplan(launchfingerprint(username, javapath), argv);
+    }
+    if (argv.empty()) {
         if (logconsole)
             logconsole("[Error] No launch arguments generated.");
-        return;
+        return false;
     }
     // Check for java.
     //
-    std::string javapath = ".minecraft\\java\\bin\\java.exe";
     if (!std::filesystem::exists(javapath))
     {
         if (logconsole)
             logconsole("[Error] Java not found: " + javapath);
-        return;
+        return false;
     }
     if (logconsole)
         logconsole("[Launch] Starting Java process...");
-    // Prepare command line: "java.exe <args>".
-    //
-    std::string commandline = "\"" + javapath + "\" " + args;
-    SECURITY_ATTRIBUTES sa;
-    sa.nLength = sizeof(SECURITY_ATTRIBUTES);
-    sa.bInheritHandle = TRUE;
-    sa.lpSecurityDescriptor = NULL;
-    HANDLE stdoutRead, stdoutWrite;
-    HANDLE stderrRead, stderrWrite;
-    // Create pipes for STDOUT.
-    //
-    CreatePipe(&stdoutRead, &stdoutWrite, &sa, 0);
-    SetHandleInformation(stdoutRead, HANDLE_FLAG_INHERIT, 0);
-    if (!CreatePipe(&stdoutRead, &stdoutWrite, &sa, 0)) {
-        if (logconsole)
-            logconsole("[Error] Failed to create stdout pipe.");
-        return;
-    }
-    // Create pipes for STDERR.
+    // The JVM appends to an existing log when rotation is off, start each session with a new one.
     //
-    CreatePipe(&stderrRead, &stderrWrite, &sa, 0);
-    SetHandleInformation(stderrRead, HANDLE_FLAG_INHERIT, 0);
-    if (!CreatePipe(&stderrRead, &stderrWrite, &sa, 0)) {
-        if (logconsole)
-            logconsole("[Error] Failed to create stderr pipe.");
-        return;
+    if (gclogging)
+    {
+        std::error_code ec;
+        fs::remove(gclogpath, ec);
     }
-    PROCESS_INFORMATION pi{};
-    STARTUPINFOA si{};
-    si.cb = sizeof(STARTUPINFO);
-    si.hStdInput = NULL;
-    si.hStdOutput = stdoutWrite;
-    si.hStdError = stderrWrite;
-    si.dwFlags |= STARTF_USESTDHANDLES;
-    // Create process.
-    //
-    BOOL success = CreateProcessA(
-        NULL,
-        commandline.data(),
-        NULL,
-        NULL,
-        TRUE,
-        CREATE_NO_WINDOW,
-        NULL,
-        NULL,
-        &si,
-        &pi
-    );
-    CloseHandle(stdoutWrite);
-    CloseHandle(stderrWrite);
-    if (!success)
+    // Start java with stdout and stderr on pipes.
+    //
+    processoptions options;
+    options.argv.reserve(argv.size() + 1);
+    options.argv.push_back(javapath);
+    options.argv.insert(options.argv.end(), argv.begin(), argv.end());
+    auto game = std::make_shared<childprocess>();
+    if (!game->start(options))
     {
         if (logconsole)
-            logconsole("[Error] Failed to start java process.");
-        return;
+            logconsole("[Error] Failed to start java process: " + game->error());
+        return false;
     }
-    // Thread: read stdout.
+    // Thread: forward stdout and stderr to the console until the game exits.
     //
-    std::thread([this, stdoutRead]() {
-        char buffer[1024];
-        DWORD bytesread;
-        while (ReadFile(stdoutRead, buffer, sizeof(buffer) - 1, &bytesread, NULL) && bytesread > 0)
+    std::thread([this, game, logging = gclogging, logpath = gclogpath, historypath = gchistorypath, heap = jvm.heapmb]() {
+        // Frame the output into lines, only lines that reach the console are copied.
+        //
+        lineframer framers[2];
+        linehandler online = [this](std::string_view line) {
+            if (logconsole && line.find_first_not_of(" \t") != std::string_view::npos)
+                logconsole(std::string(line));
+        };
+        int exitcode = game->pump([&](outputstream stream, const char* data, size_t size) {
+            framers[stream == outputstream::error ? 1 : 0].feed(data, size, online);
+        });
+        for (auto& framer : framers)
+            framer.flush(online);
+        if (logconsole)
+            logconsole("[Launch] Minecraft closed (exit code " + std::to_string(exitcode) + ").");
+        // Add this session's GC statistics to the history of the version before the UI reloads it.
+        //
+        gcsession session = logging ? gchistory::parselog(logpath) : gcsession();
+        if (session.pauses > 0 || session.peaklivemb > 0)
         {
-            buffer[bytesread] = '\0';
+            session.time = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            session.heapmb = heap;
+            gchistory history(historypath);
+            history.add(session);
             if (logconsole)
-                logconsole(std::string(buffer));
+                logconsole("[GC] Peak live " + std::to_string(session.peaklivemb) + "M of " + std::to_string(heap) + "M, "
+                    + std::to_string(session.pauses) + " pauses, longest " + std::to_string(static_cast<int>(session.maxpausems)) + " ms. "
+                    + "Next heap: " + std::to_string(history.recommendedheapmb()) + "M");
         }
-        CloseHandle(stdoutRead);
-    }).detach();
-    // Thread: read stderr.
-    //
-    std::thread([=]() {
-        WaitForSingleObject(pi.hProcess, INFINITE);
         minecraftrunning = false;
-        if (logconsole)
-            logconsole("[Launch] Minecraft closed.");
-        CloseHandle(pi.hProcess);
     }).detach();
-    CloseHandle(pi.hThread);
     if (logconsole)
-        logconsole("[Launch] Minecraft launch request sent...");
+        logconsole("[Launch] Minecraft launch request sent (pid " + std::to_string(game->pid()) + ")...");
+    return true;
 }
 
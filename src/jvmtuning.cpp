@@ -0,0 +1,185 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/jvmtuning.hpp"
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <nlohmann/json.hpp>
+#ifdef _WIN32
+// Keep windows.h from defining min and max macros over std::min and std::max.
+//
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+// Profiles from the largest machine down, the first one whose minimums are met is used.
+//
+struct jvmprofile
+{
+    const char* name;
+    uint64_t minrammb;
+    unsigned mincores;
+    uint64_t heapmb;
+    uint64_t initialmb;
+    const char* gc;
+};
+
+static const jvmprofile profiles[] =
+{
+    { "large",    24576, 8, 8192, 4096, "zgc" },
+    { "standard", 12288, 4, 4096, 2048, "g1" },
+    { "balanced",  6144, 2, 2048,  512, "g1" },
+    { "low",          0, 1, 1024,  256, "g1" },
+};
+
+// Memory left to the OS and everything else besides the game.
+//
+static const uint64_t reservedmb = 1024;
+static const uint64_t minimumheapmb = 768;
+
+hostresources hostresources::current()
+{
+    hostresources resources;
+#ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status))
+    {
+        resources.totalmb = status.ullTotalPhys / (1024 * 1024);
+        resources.availablemb = status.ullAvailPhys / (1024 * 1024);
+    }
+#else
+    long pagesize = sysconf(_SC_PAGESIZE);
+    long pages = sysconf(_SC_PHYS_PAGES);
+    if (pagesize > 0 && pages > 0)
+        resources.totalmb = static_cast<uint64_t>(pages) * static_cast<uint64_t>(pagesize) / (1024 * 1024);
+    // MemAvailable counts reclaimable caches, _SC_AVPHYS_PAGES does not.
+    //
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    uint64_t value = 0;
+    while (meminfo >> key >> value)
+    {
+        if (key == "MemAvailable:")
+        {
+            resources.availablemb = value / 1024;
+            break;
+        }
+        meminfo.ignore(64, '\n');
+    }
+    if (resources.availablemb == 0)
+    {
+        long available = sysconf(_SC_AVPHYS_PAGES);
+        if (pagesize > 0 && available > 0)
+            resources.availablemb = static_cast<uint64_t>(available) * static_cast<uint64_t>(pagesize) / (1024 * 1024);
+    }
+#endif
+    resources.cores = std::max(1u, std::thread::hardware_concurrency());
+    return resources;
+}
+
+std::string jvmsettings::summary() const
+{
+    return profile + ": " + std::to_string(heapmb) + "M heap (" + std::to_string(initialmb) + "M initial), " + gc;
+}
+
+jvmsettings choosejvmsettings(const hostresources& host, int javamajor, const std::string& overridepath, uint64_t learnedheapmb)
+{
+    json overrides = json::object();
+    {
+        std::ifstream f(overridepath);
+        if (f)
+        {
+            try {
+                f >> overrides;
+            } catch (const std::exception&) {
+                overrides = json::object();
+            }
+            if (!overrides.is_object())
+                overrides = json::object();
+        }
+    }
+    // Pick the profile, by name when the version asks for one.
+    //
+    const jvmprofile* chosen = &profiles[sizeof(profiles) / sizeof(profiles[0]) - 1];
+    std::string wanted = overrides.value("profile", "");
+    for (const auto& profile : profiles)
+    {
+        if (!wanted.empty() ? wanted == profile.name : (host.totalmb >= profile.minrammb && host.cores >= profile.mincores))
+        {
+            chosen = &profile;
+            break;
+        }
+    }
+    jvmsettings settings;
+    settings.profile = chosen->name;
+    settings.heapmb = chosen->heapmb;
+    settings.initialmb = chosen->initialmb;
+    settings.gc = chosen->gc;
+    // The working set seen in earlier sessions beats a guess from the machine size.
+    //
+    if (learnedheapmb > 0)
+    {
+        settings.heapmb = learnedheapmb;
+        settings.profile += "+learned";
+    }
+    // Fit the heap into what is free right now, in 512M steps so small changes in free
+    // memory don't change the command line from one launch to the next.
+    //
+    if (host.availablemb > 0)
+    {
+        uint64_t room = host.availablemb > reservedmb + minimumheapmb ? host.availablemb - reservedmb : minimumheapmb;
+        if (settings.heapmb > room)
+            settings.heapmb = std::max(minimumheapmb, room / 512 * 512);
+    }
+    if (overrides.contains("heap") && overrides["heap"].is_number_unsigned())
+    {
+        settings.heapmb = overrides["heap"].get<uint64_t>();
+        settings.profile += "+override";
+    }
+    if (overrides.contains("initial") && overrides["initial"].is_number_unsigned())
+        settings.initialmb = overrides["initial"].get<uint64_t>();
+    if (overrides.contains("gc") && overrides["gc"].is_string())
+        settings.gc = overrides["gc"].get<std::string>();
+    settings.initialmb = std::min(settings.initialmb, settings.heapmb);
+    // Only use ZGC on 17 and newer, older runtimes had it experimental or not at all.
+    //
+    if (settings.gc == "zgc" && javamajor < 17)
+        settings.gc = "g1";
+    settings.arguments.push_back("-Xmx" + std::to_string(settings.heapmb) + "M");
+    settings.arguments.push_back("-Xms" + std::to_string(settings.initialmb) + "M");
+    if (settings.gc == "zgc")
+    {
+        settings.arguments.push_back("-XX:+UseZGC");
+        // Generational is the only mode from 23 on, where the flag is deprecated.
+        //
+        if (javamajor >= 21 && javamajor < 23)
+            settings.arguments.push_back("-XX:+ZGenerational");
+    }
+    else
+    {
+        settings.gc = "g1";
+        settings.arguments.push_back("-XX:+UseG1GC");
+        settings.arguments.push_back("-XX:MaxGCPauseMillis=50");
+        settings.arguments.push_back("-XX:+ParallelRefProcEnabled");
+        settings.arguments.push_back("-XX:G1ReservePercent=20");
+    }
+    if (overrides.contains("arguments") && overrides["arguments"].is_array())
+    {
+        for (const auto& argument : overrides["arguments"])
+        {
+            if (argument.is_string())
+                settings.arguments.push_back(argument.get<std::string>());
+        }
+    }
+    return settings;
+}
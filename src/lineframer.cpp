@@ -0,0 +1,79 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/lineframer.hpp"
+#include <cstring>
+
+lineframer::lineframer(size_t capacity)
+    :buffer(new char[capacity > 0 ? capacity : 1]), capacity(capacity > 0 ? capacity : 1)
+{
+}
+
+void lineframer::emit(const char* data, size_t size, const linehandler& online)
+{
+    if (size > 0 && data[size - 1] == '\r')
+        size--;
+    if (online)
+        online(std::string_view(data, size));
+}
+
+void lineframer::feed(const char* data, size_t size, const linehandler& online)
+{
+    const char* end = data + size;
+    while (data < end)
+    {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', end - data));
+        if (!newline)
+        {
+            // Unfinished line, keep it until the rest arrives.
+            //
+            size_t remaining = end - data;
+            while (pending + remaining > capacity)
+            {
+                size_t take = capacity - pending;
+                std::memcpy(buffer.get() + pending, data, take);
+                emit(buffer.get(), capacity, online);
+                pending = 0;
+                data += take;
+                remaining -= take;
+            }
+            std::memcpy(buffer.get() + pending, data, remaining);
+            pending += remaining;
+            return;
+        }
+        size_t length = newline - data;
+        if (pending == 0)
+        {
+            // The whole line is in this chunk, hand it out in place.
+            //
+            emit(data, length, online);
+        }
+        else if (pending + length <= capacity)
+        {
+            std::memcpy(buffer.get() + pending, data, length);
+            emit(buffer.get(), pending + length, online);
+            pending = 0;
+        }
+        else
+        {
+            // Too long for the buffer: fill it, pass it on and finish the line in place.
+            //
+            size_t take = capacity - pending;
+            std::memcpy(buffer.get() + pending, data, take);
+            emit(buffer.get(), capacity, online);
+            pending = 0;
+            emit(data + take, length - take, online);
+        }
+        data = newline + 1;
+    }
+}
+
+void lineframer::flush(const linehandler& online)
+{
+    if (pending == 0)
+        return;
+    emit(buffer.get(), pending, online);
+    pending = 0;
+}
@@ -9,12 +9,18 @@
 #include "imgui_impl_opengl3.h"
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers.
 #include <stdio.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
 #include <vector>
 #include <string>
 #include <mutex>
 #include <thread>
 #include "../include/java.hpp"
+#include "../include/logqueue.hpp"
 #define STB_IMAGE_IMPLEMENTATION
 #include "../include/stb_image.h" 
 namespace fs = std::filesystem;
@@ -24,23 +30,70 @@ static void glfw_error_callback(int error, const char* description)
     fprintf(stderr, "GLFW Error %d: %s\n", error, description);
 }
 
-std::vector<std::string> consolelogs;
-std::mutex logmutex;
+// One console line, the timestamp is only turned into text while the line is on screen.
+//
+struct consoleline
+{
+    int64_t time = 0;
+    std::string text;
+};
+
+// Lines logged from any thread wait in logqueue until the render thread moves them into
+// its scrollback, which only the render thread touches.
+//
+logqueue<consoleline> pendinglogs;
+
+// Lines moved into the console per frame at most, the rest waits for the next frame.
+//
+static const size_t maxlogsperframe = 4096;
+
+// Lines kept in the console unless --scrollback <lines> says otherwise.
+//
+static const size_t defaultscrollback = 20000;
+
+static int64_t currenttime()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
 
 void ImGuiLog(const std::string& msg)
 {
-    // Create timestamp.
+    // Queue the message, dropped when the console is too far behind.
     //
-    auto now = std::chrono::system_clock::now();
-    std::time_t t = std::chrono::system_clock::to_time_t(now);
+    pendinglogs.push(consoleline{ currenttime(), msg });
+}
+
+// This function moves the queued lines into the console, called once per frame.
+//
+static void drainlogs(logring<consoleline>& console)
+{
+    consoleline line;
+    for (size_t i = 0; i < maxlogsperframe && pendinglogs.pop(line); i++)
+        console.push(std::move(line));
+    size_t dropped = pendinglogs.takedropped();
+    if (dropped > 0)
+        console.push(consoleline{ currenttime(), "[Warn] " + std::to_string(dropped) + " log lines dropped." });
+}
+
+// This function formats a timestamp as "[hh:mm:ss] " in local time. Neighbouring rows
+// mostly share their second, so the last result is reused.
+//
+static const char* formattime(int64_t time)
+{
+    static int64_t lasttime = -1;
+    static char buffer[16];
+    if (time == lasttime)
+        return buffer;
+    std::time_t t = static_cast<std::time_t>(time);
     std::tm tm;
+#ifdef _WIN32
     localtime_s(&tm, &t);
-    char buf[16];
-    snprintf(buf, sizeof(buf), "%02d:%02d:%02d",
-        tm.tm_hour, tm.tm_min, tm.tm_sec);
-    // Push final formatted message.
-    //
-    consolelogs.push_back(std::string("[") + buf + "] " + msg);
+#else
+    localtime_r(&t, &tm);
+#endif
+    snprintf(buffer, sizeof(buffer), "[%02d:%02d:%02d] ", tm.tm_hour, tm.tm_min, tm.tm_sec);
+    lasttime = time;
+    return buffer;
 }
 
 // Change mode to dark or light.
@@ -49,8 +102,16 @@ bool mode = true;
 
 // Main code.
 //
-int main(int, char**)
+int main(int argc, char** argv)
 {
+    size_t scrollback = defaultscrollback;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--scrollback") == 0)
+            scrollback = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+    }
+    logring<consoleline> consolelogs(scrollback);
+
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit())
         return 1;
@@ -140,6 +201,16 @@ int main(int, char**)
         versionitems.push_back("error: no versions found.");
 
     char buf[64] = "";
+    // Version id typed by the user, installed from Mojang's manifest when it isn't on disk yet.
+    //
+    char installbuf[32] = "";
+    // Heap sizes learned from GC logs, and the history line shown for the chosen version.
+    //
+    bool learnheap = true;
+    std::string gcsummary;
+    std::string gcnextheap;
+    std::string gcsummaryversion;
+    bool gcsummaryrunning = false;
     int selected = 0;
     static launcher* launcherglobal = nullptr;
     // booleans for popups.
@@ -285,7 +356,9 @@ int main(int, char**)
                     launchpopup = true;
 
                     std::string selectedversion;
-                    if (!versionitems.empty() && versionitems[selected] && std::string(versionitems[selected]).find("error") == std::string::npos)
+                    if (installbuf[0] != '\0')
+                        selectedversion = installbuf;
+                    else if (!versionitems.empty() && versionitems[selected] && std::string(versionitems[selected]).find("error") == std::string::npos)
                         selectedversion = versionitems[selected];
                     static std::mutex launchermutex;
                     std::lock_guard<std::mutex> lock(launchermutex);
@@ -297,10 +370,12 @@ int main(int, char**)
                     // Use 1.21 as default version if no custom version is given.
                     //
                     launcher* launcherinstance = !selectedversion.empty() ? new launcher(selectedversion, ImGuiLog) : new launcher("1.21", ImGuiLog);
+                    launcherinstance->setgclogging(learnheap);
                     launcherglobal = launcherinstance;
                     launcher* threadlauncher = launcherinstance;
                     std::thread([threadlauncher, username]() {
-                        threadlauncher->launchprocess(username);
+                        if (!threadlauncher->launchprocess(username))
+                            minecraftrunning = false;
                     }).detach();
                     }
                 }
@@ -330,6 +405,32 @@ int main(int, char**)
             ImGui::PopStyleVar();
             ImGui::PopItemWidth();
 
+            ImGui::SetCursorPos(ImVec2(10, 165));
+            ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 4.0f);
+            ImGui::PushItemWidth(200);
+            ImGui::InputTextWithHint("##install", "or install version id", installbuf, sizeof(installbuf));
+            ImGui::PopStyleVar();
+            ImGui::PopItemWidth();
+
+            // Reload the GC history when another version is chosen or the game just closed.
+            //
+            std::string shownversion = installbuf[0] != '\0' ? std::string(installbuf) : std::string(versionitems[selected]);
+            if (shownversion != gcsummaryversion || gcsummaryrunning != minecraftrunning)
+            {
+                gcsummaryversion = shownversion;
+                gcsummaryrunning = minecraftrunning;
+                gchistory history((fs::path(versionspath) / shownversion / "gchistory.json").string());
+                gcsummary = history.summary();
+                uint64_t nextheap = history.recommendedheapmb();
+                gcnextheap = nextheap > 0 ? "next heap " + std::to_string(nextheap) + "M" : "no GC history yet";
+            }
+            ImGui::SetCursorPos(ImVec2(10, 190));
+            ImGui::Checkbox("Learn heap size", &learnheap);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s", gcsummary.c_str());
+            ImGui::SetCursorPos(ImVec2(10, 215));
+            ImGui::TextDisabled("%s", gcnextheap.c_str());
+
             ImGui::End();
             ImGui::PopStyleVar();
         }
@@ -353,12 +454,22 @@ int main(int, char**)
             //
             static bool scrolly = true;
             {
-                std::lock_guard<std::mutex> lock(logmutex);
+                drainlogs(consolelogs);
                 if (ImGui::GetScrollY() < ImGui::GetScrollMaxY())
                     scrolly = false; else scrolly = true;
-                for (const auto& line : consolelogs)
+                // Only the rows in view are laid out.
+                //
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(consolelogs.size()));
+                while (clipper.Step())
                 {
-                    ImGui::TextUnformatted(line.c_str());
+                    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                    {
+                        const consoleline& line = consolelogs[i];
+                        ImGui::TextUnformatted(formattime(line.time));
+                        ImGui::SameLine(0.0f, 0.0f);
+                        ImGui::TextUnformatted(line.text.c_str(), line.text.c_str() + line.text.size());
+                    }
                 }
                 if (scrolly)
                     ImGui::SetScrollHereY(1.0f);
@@ -0,0 +1,871 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/manifest.hpp"
+#include "../include/sha1.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+// Stands in for missing objects so lookups can bind a reference without copying.
+//
+static const json emptyjson;
+
+// Layout of the binary caches: a header, the fixed record of the file kind right after it,
+// then every table at an 8-byte aligned offset. The caches are only read on the machine that
+// wrote them, so the records are stored as they are in memory.
+// Bump cacheschema whenever one of the records in manifest.hpp changes.
+//
+static const char cachemagic[4] = { 'C', 'C', 'L', 'B' };
+static const uint32_t cacheschema = 1;
+static const uint32_t versionkind = 1;
+static const uint32_t assetkind = 2;
+
+struct cacheheader
+{
+    char magic[4];
+    uint32_t schema;
+    uint32_t kind;
+    uint32_t recordsize;
+    char sha1[40];
+    uint64_t filesize;
+};
+
+struct cachesection
+{
+    uint64_t offset = 0;
+    uint64_t count = 0;
+};
+
+struct versionrecord
+{
+    stringref id;
+    stringref type;
+    stringref mainclass;
+    stringref assets;
+    stringref assetindexid;
+    manifestartifact assetindex;
+    manifestartifact client;
+    stringref javacomponent;
+    uint32_t javamajor = 0;
+    uint32_t legacyarguments = 0;
+    cachesection strings;
+    cachesection libraries;
+    cachesection rules;
+    cachesection features;
+    cachesection natives;
+    cachesection classifiers;
+    cachesection gamearguments;
+    cachesection jvmarguments;
+    cachesection argumentvalues;
+};
+
+struct assetrecord
+{
+    cachesection strings;
+    cachesection objects;
+};
+
+// The binary cache of a JSON file: same folder and name, .bin extension.
+//
+static std::string cachepathfor(const std::string& jsonpath)
+{
+    return fs::path(jsonpath).replace_extension(".bin").string();
+}
+
+// Read-only mapping of a whole cache file.
+//
+struct mappedfile : flatfile::owner
+{
+    const char* data = nullptr;
+    uint64_t size = 0;
+
+    ~mappedfile()
+    {
+        if (!data)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<char*>(data), size);
+#endif
+    }
+
+    bool open(const std::string& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER length;
+        if (!GetFileSizeEx(file, &length) || length.QuadPart < static_cast<LONGLONG>(sizeof(cacheheader)))
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+        // The view keeps the file mapped after both handles are closed.
+        //
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+        size = static_cast<uint64_t>(length.QuadPart);
+        return data != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(cacheheader)))
+        {
+            close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED)
+            return false;
+        data = static_cast<const char*>(view);
+        size = static_cast<uint64_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    // Returns the record of a cache written for this kind and JSON content, or nullptr.
+    //
+    const void* record(uint32_t kind, size_t recordsize, const std::string& sha1) const
+    {
+        const cacheheader* header = reinterpret_cast<const cacheheader*>(data);
+        if (std::memcmp(header->magic, cachemagic, sizeof(cachemagic)) != 0
+            || header->schema != cacheschema
+            || header->kind != kind
+            || header->recordsize != recordsize
+            || header->filesize != size
+            || sha1.size() != sizeof(header->sha1)
+            || std::memcmp(header->sha1, sha1.data(), sizeof(header->sha1)) != 0
+            || size < sizeof(cacheheader) + recordsize)
+            return nullptr;
+        return data + sizeof(cacheheader);
+    }
+
+    // Points a table at its section, fails when the section doesn't fit in the file.
+    //
+    template <typename T>
+    bool view(const cachesection& section, table<T>& target) const
+    {
+        if (section.offset % alignof(T) != 0 || section.offset > size || section.count > (size - section.offset) / sizeof(T))
+            return false;
+        target.data = reinterpret_cast<const T*>(data + section.offset);
+        target.count = static_cast<uint32_t>(section.count);
+        return true;
+    }
+
+    bool strings(const cachesection& section, const char*& target, uint32_t& length) const
+    {
+        if (section.offset > size || section.count > size - section.offset)
+            return false;
+        target = data + section.offset;
+        length = static_cast<uint32_t>(section.count);
+        return true;
+    }
+};
+
+// Builds a cache file in memory, then writes it next to the JSON.
+//
+class cachewriter
+{
+public:
+    cachewriter(size_t recordsize)
+        :buffer(sizeof(cacheheader) + recordsize, '\0')
+    {
+        align();
+    }
+public:
+    template <typename T>
+    cachesection add(const T* data, size_t count)
+    {
+        cachesection section;
+        section.offset = buffer.size();
+        section.count = count;
+        if (count > 0)
+            buffer.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+        align();
+        return section;
+    }
+
+    // Fills in the header and record and renames the finished file into place.
+    // A cache that can't be written only costs a parse on the next run, so errors are ignored.
+    //
+    void write(const std::string& cachepath, uint32_t kind, const void* record, size_t recordsize, const std::string& sha1)
+    {
+        if (sha1.size() != 40)
+            return;
+        cacheheader header;
+        std::memcpy(header.magic, cachemagic, sizeof(cachemagic));
+        header.schema = cacheschema;
+        header.kind = kind;
+        header.recordsize = static_cast<uint32_t>(recordsize);
+        std::memcpy(header.sha1, sha1.data(), sizeof(header.sha1));
+        header.filesize = buffer.size();
+        std::memcpy(&buffer[0], &header, sizeof(header));
+        std::memcpy(&buffer[sizeof(header)], record, recordsize);
+        std::string partpath = cachepath + ".part";
+        {
+            std::ofstream f(partpath, std::ios::binary | std::ios::trunc);
+            if (!f)
+                return;
+            f.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (!f)
+                return;
+        }
+        std::error_code ec;
+        fs::rename(partpath, cachepath, ec);
+        if (ec)
+            fs::remove(partpath, ec);
+    }
+
+private:
+    void align()
+    {
+        buffer.resize((buffer.size() + 7) & ~size_t(7), '\0');
+    }
+    std::string buffer;
+};
+
+// String table shared by everything parsed from one JSON file.
+//
+struct stringpool
+{
+    std::string strings;
+    std::unordered_map<std::string, stringref> interned;
+
+    // Adds a string to the table once and returns where it lives.
+    //
+    stringref intern(const std::string& value)
+    {
+        if (value.empty())
+            return stringref();
+        auto it = interned.find(value);
+        if (it != interned.end())
+            return it->second;
+        stringref ref;
+        ref.offset = static_cast<uint32_t>(strings.size());
+        ref.length = static_cast<uint32_t>(value.size());
+        strings += value;
+        interned.emplace(value, ref);
+        return ref;
+    }
+
+    stringref intern(const json& object, const char* key)
+    {
+        if (!object.is_object() || !object.contains(key) || !object[key].is_string())
+            return stringref();
+        return intern(object[key].get<std::string>());
+    }
+};
+
+// Walks a JSON file with nlohmann's SAX interface instead of building the whole document.
+// Only values whose path select() accepts are built, one at a time, and handed to collect().
+// A path is the keys from the root down to the value, array elements are "[]".
+//
+class jsonstream : public nlohmann::json_sax<json>
+{
+public:
+    virtual ~jsonstream() = default;
+public:
+    // Parses the file, throws std::runtime_error when it can't be opened or isn't valid JSON.
+    //
+    void parse(const std::string& jsonpath)
+    {
+        std::ifstream f(jsonpath, std::ios::binary);
+        if (!f)
+            throw std::runtime_error("Failed to open JSON: " + jsonpath);
+        try {
+            json::sax_parse(f, this);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to parse JSON: " + jsonpath + " (" + e.what() + ")");
+        }
+    }
+
+    bool null() override { return value(json()); }
+    bool boolean(bool v) override { return value(v); }
+    bool number_integer(number_integer_t v) override { return value(v); }
+    bool number_unsigned(number_unsigned_t v) override { return value(v); }
+    bool number_float(number_float_t v, const string_t&) override { return value(v); }
+    bool string(string_t& v) override { return value(std::move(v)); }
+    bool binary(binary_t& v) override { return value(json::binary(std::move(v))); }
+    bool start_object(std::size_t) override { return start(json::object(), ""); }
+    bool start_array(std::size_t) override { return start(json::array(), "[]"); }
+    bool end_object() override { return end(); }
+    bool end_array() override { return end(); }
+
+    bool key(string_t& k) override
+    {
+        path.back() = k;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override
+    {
+        throw std::runtime_error(e.what());
+    }
+
+protected:
+    // Called for every value that isn't inside a value being built.
+    //
+    virtual bool select(const std::vector<std::string>& at) = 0;
+    virtual void collect(const std::vector<std::string>& at, json&& value) = 0;
+    // Called when an object or array that wasn't selected ends.
+    //
+    virtual void finished(const std::vector<std::string>&) {}
+
+private:
+    // Adds a value to the container being built and returns where it ended up.
+    //
+    json* insert(json&& v)
+    {
+        if (building.empty())
+        {
+            root = std::move(v);
+            return &root;
+        }
+        json& parent = *building.back();
+        if (parent.is_array())
+        {
+            parent.push_back(std::move(v));
+            return &parent.back();
+        }
+        json& slot = parent[path.back()];
+        slot = std::move(v);
+        return &slot;
+    }
+
+    bool value(json&& v)
+    {
+        if (!building.empty())
+            insert(std::move(v));
+        else if (select(path))
+            collect(path, std::move(v));
+        return true;
+    }
+
+    bool start(json&& container, const char* element)
+    {
+        if (!building.empty() || select(path))
+            building.push_back(insert(std::move(container)));
+        path.emplace_back(element);
+        return true;
+    }
+
+    bool end()
+    {
+        path.pop_back();
+        if (building.empty())
+        {
+            finished(path);
+            return true;
+        }
+        building.pop_back();
+        if (building.empty())
+        {
+            collect(path, std::move(root));
+            root = json();
+        }
+        return true;
+    }
+
+    std::vector<std::string> path;
+    std::vector<json*> building;
+    json root;
+};
+
+// Arrays a manifest parsed from JSON owns, the tables point into them.
+//
+struct versionstorage : flatfile::owner, stringpool
+{
+    std::vector<manifestlibrary> libraries;
+    std::vector<manifestrule> rules;
+    std::vector<manifestfeature> features;
+    std::vector<manifestnative> natives;
+    std::vector<manifestclassifier> classifiers;
+    std::vector<manifestargument> gamearguments;
+    std::vector<manifestargument> jvmarguments;
+    std::vector<stringref> argumentvalues;
+
+    manifestartifact artifact(const json& object)
+    {
+        manifestartifact a;
+        a.path = intern(object, "path");
+        a.url = intern(object, "url");
+        a.sha1 = intern(object, "sha1");
+        a.size = object.value("size", uint64_t(0));
+        return a;
+    }
+
+    // Appends a "rules" array and returns its first index and count.
+    //
+    void addrules(const json& object, uint32_t& first, uint32_t& count)
+    {
+        first = static_cast<uint32_t>(rules.size());
+        count = 0;
+        if (!object.contains("rules") || !object["rules"].is_array())
+            return;
+        for (const auto& r : object["rules"])
+        {
+            manifestrule rule;
+            rule.allow = r.value("action", "allow") == "allow" ? 1 : 0;
+            if (r.contains("os"))
+            {
+                rule.osname = intern(r["os"], "name");
+                rule.osarch = intern(r["os"], "arch");
+                rule.osversion = intern(r["os"], "version");
+            }
+            rule.firstfeature = static_cast<uint32_t>(features.size());
+            if (r.contains("features") && r["features"].is_object())
+            {
+                for (const auto& feature : r["features"].items())
+                {
+                    manifestfeature f;
+                    f.name = intern(feature.key());
+                    f.value = feature.value().is_boolean() && feature.value().get<bool>() ? 1 : 0;
+                    features.push_back(f);
+                    rule.featurecount++;
+                }
+            }
+            rules.push_back(rule);
+            count++;
+        }
+    }
+
+    // Appends one entry of arguments.game or arguments.jvm.
+    //
+    void addargument(std::vector<manifestargument>& target, const json& entry)
+    {
+        manifestargument argument;
+        argument.firstvalue = static_cast<uint32_t>(argumentvalues.size());
+        if (entry.is_string())
+        {
+            argumentvalues.push_back(intern(entry.get<std::string>()));
+            argument.valuecount = 1;
+            argument.firstrule = static_cast<uint32_t>(rules.size());
+        }
+        else if (entry.is_object())
+        {
+            const json& value = entry.contains("value") ? entry["value"] : emptyjson;
+            if (value.is_string())
+            {
+                argumentvalues.push_back(intern(value.get<std::string>()));
+                argument.valuecount = 1;
+            }
+            else if (value.is_array())
+            {
+                for (const auto& v : value)
+                {
+                    if (!v.is_string())
+                        continue;
+                    argumentvalues.push_back(intern(v.get<std::string>()));
+                    argument.valuecount++;
+                }
+            }
+            addrules(entry, argument.firstrule, argument.rulecount);
+        }
+        if (argument.valuecount > 0)
+            target.push_back(argument);
+    }
+};
+
+struct assetstorage : flatfile::owner, stringpool
+{
+    std::vector<assetobject> objects;
+};
+
+// Streams a version JSON into a versionstorage. Libraries and argument entries are built
+// one element at a time, everything the launcher doesn't use is skipped.
+//
+class versionstream : public jsonstream
+{
+public:
+    versionstream(versionmanifest& manifest, versionstorage& s)
+        :manifest(manifest), s(s)
+    {
+    }
+public:
+    bool haslibraries = false;
+    bool hasarguments = false;
+    std::string legacyarguments;
+
+protected:
+    bool select(const std::vector<std::string>& at) override
+    {
+        if (at.size() == 1)
+        {
+            const std::string& key = at[0];
+            if (key == "libraries")
+                haslibraries = true;
+            if (key == "arguments")
+                hasarguments = true;
+            return key == "id" || key == "type" || key == "mainClass" || key == "assets"
+                || key == "assetIndex" || key == "javaVersion" || key == "minecraftArguments";
+        }
+        if (at.size() == 2)
+            return at[0] == "libraries" || (at[0] == "downloads" && at[1] == "client");
+        if (at.size() == 3)
+            return at[0] == "arguments" && (at[1] == "game" || at[1] == "jvm");
+        return false;
+    }
+
+    void collect(const std::vector<std::string>& at, json&& value) override
+    {
+        if (at.size() == 3)
+        {
+            s.addargument(at[1] == "game" ? s.gamearguments : s.jvmarguments, value);
+            return;
+        }
+        if (at.size() == 2)
+        {
+            if (at[0] == "libraries")
+                addlibrary(value);
+            else
+                manifest.client = s.artifact(value);
+            return;
+        }
+        const std::string& key = at[0];
+        if (key == "assetIndex" && value.is_object())
+        {
+            manifest.assetindexid = s.intern(value, "id");
+            manifest.assetindex = s.artifact(value);
+        }
+        else if (key == "javaVersion" && value.is_object())
+        {
+            manifest.javacomponent = s.intern(value, "component");
+            manifest.javamajor = value.value("majorVersion", uint32_t(0));
+        }
+        else if (value.is_string())
+        {
+            std::string text = value.get<std::string>();
+            if (key == "id")
+                manifest.id = s.intern(text);
+            else if (key == "type")
+                manifest.type = s.intern(text);
+            else if (key == "mainClass")
+                manifest.mainclass = s.intern(text);
+            else if (key == "assets")
+                manifest.assets = s.intern(text);
+            else if (key == "minecraftArguments")
+                legacyarguments = std::move(text);
+        }
+    }
+
+private:
+    void addlibrary(const json& lib)
+    {
+        manifestlibrary library;
+        library.name = s.intern(lib, "name");
+        s.addrules(lib, library.firstrule, library.rulecount);
+        const json& downloads = lib.contains("downloads") ? lib["downloads"] : emptyjson;
+        if (downloads.is_object() && downloads.contains("artifact"))
+        {
+            library.hasartifact = 1;
+            library.artifact = s.artifact(downloads["artifact"]);
+        }
+        library.firstnative = static_cast<uint32_t>(s.natives.size());
+        if (lib.contains("natives") && lib["natives"].is_object())
+        {
+            for (const auto& native : lib["natives"].items())
+            {
+                if (!native.value().is_string())
+                    continue;
+                s.natives.push_back({ s.intern(native.key()), s.intern(native.value().get<std::string>()) });
+                library.nativecount++;
+            }
+        }
+        library.firstclassifier = static_cast<uint32_t>(s.classifiers.size());
+        if (downloads.is_object() && downloads.contains("classifiers") && downloads["classifiers"].is_object())
+        {
+            for (const auto& classifier : downloads["classifiers"].items())
+            {
+                s.classifiers.push_back({ s.intern(classifier.key()), s.artifact(classifier.value()) });
+                library.classifiercount++;
+            }
+        }
+        s.libraries.push_back(library);
+    }
+
+    versionmanifest& manifest;
+    versionstorage& s;
+};
+
+// Streams an asset index straight into assetobject records without building any JSON values.
+//
+class assetstream : public jsonstream
+{
+public:
+    assetstream(assetstorage& s)
+        :s(s)
+    {
+    }
+public:
+    bool hasobjects = false;
+
+protected:
+    bool select(const std::vector<std::string>& at) override
+    {
+        if (at.size() == 1 && at[0] == "objects")
+            hasobjects = true;
+        return at.size() == 3 && at[0] == "objects" && (at[2] == "hash" || at[2] == "size");
+    }
+
+    void collect(const std::vector<std::string>& at, json&& value) override
+    {
+        if (at[2] == "hash" && value.is_string())
+            current.hash = s.intern(value.get_ref<const std::string&>());
+        else if (at[2] == "size" && value.is_number_integer())
+            current.size = value.get<uint64_t>();
+    }
+
+    void finished(const std::vector<std::string>& at) override
+    {
+        if (at.size() != 2 || at[0] != "objects")
+            return;
+        s.objects.push_back(current);
+        current = assetobject();
+    }
+
+private:
+    assetstorage& s;
+    assetobject current;
+};
+
+// Points a table at a finished array.
+//
+template <typename T>
+static void view(const std::vector<T>& vector, table<T>& target)
+{
+    target.data = vector.data();
+    target.count = static_cast<uint32_t>(vector.size());
+}
+
+bool flatfile::loaded() const
+{
+    return strings != nullptr;
+}
+
+bool flatfile::cached() const
+{
+    return frommapping;
+}
+
+std::string_view flatfile::str(stringref ref) const
+{
+    if (ref.length == 0)
+        return std::string_view();
+    return std::string_view(strings + ref.offset, ref.length);
+}
+
+std::string flatfile::string(stringref ref) const
+{
+    return std::string(str(ref));
+}
+
+// This function loads a version JSON, from its binary cache when that is still current.
+//
+versionmanifest versionmanifest::load(const std::string& jsonpath)
+{
+    std::string sha1 = sha1hash::file(jsonpath);
+    if (sha1.empty())
+        throw std::runtime_error("Failed to open JSON: " + jsonpath);
+    std::string cachepath = cachepathfor(jsonpath);
+    versionmanifest manifest;
+    if (manifest.map(cachepath, sha1))
+        return manifest;
+    manifest = parse(jsonpath);
+    manifest.save(cachepath, sha1);
+    return manifest;
+}
+
+// This function streams the version JSON once into the flat tables.
+//
+versionmanifest versionmanifest::parse(const std::string& jsonpath)
+{
+    versionmanifest manifest;
+    auto storage = std::make_unique<versionstorage>();
+    versionstorage& s = *storage;
+    versionstream stream(manifest, s);
+    stream.parse(jsonpath);
+    if (!stream.haslibraries)
+        throw std::runtime_error("Version JSON missing 'libraries' array.");
+    // Versions before 1.13 have a flat minecraftArguments string instead of the "arguments" object.
+    //
+    if (!stream.hasarguments && !stream.legacyarguments.empty())
+    {
+        manifest.legacyarguments = 1;
+        const std::string& legacy = stream.legacyarguments;
+        size_t start = 0;
+        while (start < legacy.size())
+        {
+            size_t end = legacy.find(' ', start);
+            if (end == std::string::npos)
+                end = legacy.size();
+            if (end > start)
+                s.addargument(s.gamearguments, json(legacy.substr(start, end - start)));
+            start = end + 1;
+        }
+    }
+    // Point the tables at the finished arrays, the interning map is no longer needed.
+    //
+    s.interned.clear();
+    view(s.libraries, manifest.libraries);
+    view(s.rules, manifest.rules);
+    view(s.features, manifest.features);
+    view(s.natives, manifest.natives);
+    view(s.classifiers, manifest.classifiers);
+    view(s.gamearguments, manifest.gamearguments);
+    view(s.jvmarguments, manifest.jvmarguments);
+    view(s.argumentvalues, manifest.argumentvalues);
+    manifest.strings = s.strings.c_str();
+    manifest.stringsize = static_cast<uint32_t>(s.strings.size());
+    manifest.owned = std::move(storage);
+    return manifest;
+}
+
+// This function points the tables into the binary cache, the file stays mapped while the manifest lives.
+//
+bool versionmanifest::map(const std::string& cachepath, const std::string& sha1)
+{
+    auto file = std::make_unique<mappedfile>();
+    if (!file->open(cachepath))
+        return false;
+    const versionrecord* record = static_cast<const versionrecord*>(file->record(versionkind, sizeof(versionrecord), sha1));
+    if (!record
+        || !file->strings(record->strings, strings, stringsize)
+        || !file->view(record->libraries, libraries)
+        || !file->view(record->rules, rules)
+        || !file->view(record->features, features)
+        || !file->view(record->natives, natives)
+        || !file->view(record->classifiers, classifiers)
+        || !file->view(record->gamearguments, gamearguments)
+        || !file->view(record->jvmarguments, jvmarguments)
+        || !file->view(record->argumentvalues, argumentvalues))
+    {
+        *this = versionmanifest();
+        return false;
+    }
+    id = record->id;
+    type = record->type;
+    mainclass = record->mainclass;
+    assets = record->assets;
+    assetindexid = record->assetindexid;
+    assetindex = record->assetindex;
+    client = record->client;
+    javacomponent = record->javacomponent;
+    javamajor = record->javamajor;
+    legacyarguments = record->legacyarguments;
+    frommapping = true;
+    owned = std::move(file);
+    return true;
+}
+
+void versionmanifest::save(const std::string& cachepath, const std::string& sha1) const
+{
+    versionrecord record;
+    cachewriter writer(sizeof(record));
+    record.id = id;
+    record.type = type;
+    record.mainclass = mainclass;
+    record.assets = assets;
+    record.assetindexid = assetindexid;
+    record.assetindex = assetindex;
+    record.client = client;
+    record.javacomponent = javacomponent;
+    record.javamajor = javamajor;
+    record.legacyarguments = legacyarguments;
+    record.strings = writer.add(strings, stringsize);
+    record.libraries = writer.add(libraries.data, libraries.count);
+    record.rules = writer.add(rules.data, rules.count);
+    record.features = writer.add(features.data, features.count);
+    record.natives = writer.add(natives.data, natives.count);
+    record.classifiers = writer.add(classifiers.data, classifiers.count);
+    record.gamearguments = writer.add(gamearguments.data, gamearguments.count);
+    record.jvmarguments = writer.add(jvmarguments.data, jvmarguments.count);
+    record.argumentvalues = writer.add(argumentvalues.data, argumentvalues.count);
+    writer.write(cachepath, versionkind, &record, sizeof(record), sha1);
+}
+
+// This function loads an asset index, from its binary cache when that is still current.
+//
+assetmanifest assetmanifest::load(const std::string& jsonpath)
+{
+    std::string sha1 = sha1hash::file(jsonpath);
+    if (sha1.empty())
+        throw std::runtime_error("Failed to open asset index: " + jsonpath);
+    std::string cachepath = cachepathfor(jsonpath);
+    assetmanifest index;
+    if (index.map(cachepath, sha1))
+        return index;
+    index = parse(jsonpath);
+    index.save(cachepath, sha1);
+    return index;
+}
+
+assetmanifest assetmanifest::parse(const std::string& jsonpath)
+{
+    assetmanifest index;
+    auto storage = std::make_unique<assetstorage>();
+    assetstorage& s = *storage;
+    assetstream stream(s);
+    stream.parse(jsonpath);
+    if (!stream.hasobjects)
+        throw std::runtime_error("Asset index missing 'objects'.");
+    s.interned.clear();
+    view(s.objects, index.objects);
+    index.strings = s.strings.c_str();
+    index.stringsize = static_cast<uint32_t>(s.strings.size());
+    index.owned = std::move(storage);
+    return index;
+}
+
+bool assetmanifest::map(const std::string& cachepath, const std::string& sha1)
+{
+    auto file = std::make_unique<mappedfile>();
+    if (!file->open(cachepath))
+        return false;
+    const assetrecord* record = static_cast<const assetrecord*>(file->record(assetkind, sizeof(assetrecord), sha1));
+    if (!record
+        || !file->strings(record->strings, strings, stringsize)
+        || !file->view(record->objects, objects))
+    {
+        *this = assetmanifest();
+        return false;
+    }
+    frommapping = true;
+    owned = std::move(file);
+    return true;
+}
+
+void assetmanifest::save(const std::string& cachepath, const std::string& sha1) const
+{
+    assetrecord record;
+    cachewriter writer(sizeof(record));
+    record.strings = writer.add(strings, stringsize);
+    record.objects = writer.add(objects.data, objects.count);
+    writer.write(cachepath, assetkind, &record, sizeof(record), sha1);
+}
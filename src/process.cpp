@@ -0,0 +1,525 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/process.hpp"
+#ifdef _WIN32
+#include <atomic>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#endif
+extern char** environ;
+#endif
+
+// Size of the buffer each pipe is read into.
+//
+static const size_t pumpbuffersize = 16384;
+
+childprocess::~childprocess()
+{
+    closehandles();
+}
+
+const std::string& childprocess::error() const
+{
+    return message;
+}
+
+long childprocess::pid() const
+{
+    return static_cast<long>(id);
+}
+
+#ifdef _WIN32
+
+// Quotes an argument so the MSVC runtime of the child splits it back into the same string.
+// Backslashes only need doubling when they end up in front of a quote.
+//
+static std::string quoteargument(const std::string& argument)
+{
+    if (!argument.empty() && argument.find_first_of(" \t\n\v\"") == std::string::npos)
+        return argument;
+    std::string quoted = "\"";
+    size_t backslashes = 0;
+    for (char c : argument)
+    {
+        if (c == '\\')
+        {
+            backslashes++;
+            continue;
+        }
+        quoted.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+        quoted += c;
+        backslashes = 0;
+    }
+    quoted.append(backslashes * 2, '\\');
+    quoted += '"';
+    return quoted;
+}
+
+// This function creates a pipe whose read end supports overlapped I/O, which anonymous
+// pipes from CreatePipe don't. Only the write end is inheritable.
+//
+static bool createoverlappedpipe(HANDLE& readend, HANDLE& writeend)
+{
+    static std::atomic<unsigned> counter{ 0 };
+    std::string name = "\\\\.\\pipe\\cclauncher-" + std::to_string(GetCurrentProcessId()) + "-" + std::to_string(counter++);
+    readend = CreateNamedPipeA(name.c_str(),
+        PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+        PIPE_TYPE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+        1, 0, static_cast<DWORD>(pumpbuffersize * 4), 0, NULL);
+    if (readend == INVALID_HANDLE_VALUE)
+        return false;
+    SECURITY_ATTRIBUTES sa;
+    sa.nLength = sizeof(SECURITY_ATTRIBUTES);
+    sa.bInheritHandle = TRUE;
+    sa.lpSecurityDescriptor = NULL;
+    writeend = CreateFileA(name.c_str(), GENERIC_WRITE, 0, &sa, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (writeend == INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(readend);
+        return false;
+    }
+    return true;
+}
+
+void childprocess::closehandles()
+{
+    for (void** handle : { &process, &output, &errors })
+    {
+        if (*handle)
+            CloseHandle(*handle);
+        *handle = nullptr;
+    }
+}
+
+bool childprocess::start(const processoptions& options)
+{
+    if (options.argv.empty())
+    {
+        message = "No program to start.";
+        return false;
+    }
+    // Command line: every argument quoted so the child sees exactly argv.
+    //
+    std::string commandline;
+    for (const auto& argument : options.argv)
+    {
+        if (!commandline.empty())
+            commandline += " ";
+        commandline += quoteargument(argument);
+    }
+    if (commandline.size() >= 32767)
+    {
+        message = "Command line too long (" + std::to_string(commandline.size()) + " characters).";
+        return false;
+    }
+    // Environment block: "NAME=value\0" entries closed by one more "\0".
+    //
+    std::string environment;
+    for (const auto& entry : options.env)
+    {
+        environment += entry;
+        environment += '\0';
+    }
+    environment += '\0';
+    // One pipe per stream, only the write ends are inherited by the child.
+    //
+    HANDLE outread = NULL, outwrite = NULL;
+    HANDLE errread = NULL, errwrite = NULL;
+    if (!createoverlappedpipe(outread, outwrite))
+    {
+        message = "Failed to create stdout pipe.";
+        return false;
+    }
+    if (!createoverlappedpipe(errread, errwrite))
+    {
+        CloseHandle(outread);
+        CloseHandle(outwrite);
+        message = "Failed to create stderr pipe.";
+        return false;
+    }
+    PROCESS_INFORMATION pi{};
+    STARTUPINFOA si{};
+    si.cb = sizeof(STARTUPINFOA);
+    si.hStdInput = NULL;
+    si.hStdOutput = outwrite;
+    si.hStdError = errwrite;
+    si.dwFlags |= STARTF_USESTDHANDLES;
+    BOOL success = CreateProcessA(
+        NULL,
+        commandline.data(),
+        NULL,
+        NULL,
+        TRUE,
+        CREATE_NO_WINDOW,
+        options.env.empty() ? NULL : environment.data(),
+        options.cwd.empty() ? NULL : options.cwd.c_str(),
+        &si,
+        &pi
+    );
+    // The child has its own copies of the write ends now.
+    //
+    CloseHandle(outwrite);
+    CloseHandle(errwrite);
+    if (!success)
+    {
+        CloseHandle(outread);
+        CloseHandle(errread);
+        message = "CreateProcess failed with error " + std::to_string(GetLastError()) + ".";
+        return false;
+    }
+    CloseHandle(pi.hThread);
+    process = pi.hProcess;
+    output = outread;
+    errors = errread;
+    id = pi.dwProcessId;
+    return true;
+}
+
+// One pipe with the read that is currently in flight on it.
+//
+struct pumpedpipe
+{
+    HANDLE pipe = NULL;
+    outputstream stream = outputstream::output;
+    OVERLAPPED overlapped{};
+    bool open = false;
+    char buffer[pumpbuffersize];
+
+    // Starts the next read, the event is signaled when it completes (even right away).
+    //
+    void read()
+    {
+        ResetEvent(overlapped.hEvent);
+        if (!ReadFile(pipe, buffer, static_cast<DWORD>(sizeof(buffer)), NULL, &overlapped) && GetLastError() != ERROR_IO_PENDING)
+            open = false;
+    }
+};
+
+int childprocess::pump(const outputhandler& onoutput)
+{
+    if (!process)
+        return exitcode;
+    pumpedpipe pipes[2];
+    pipes[0].pipe = output;
+    pipes[0].stream = outputstream::output;
+    pipes[1].pipe = errors;
+    pipes[1].stream = outputstream::error;
+    for (auto& p : pipes)
+    {
+        p.overlapped.hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+        p.open = p.pipe && p.overlapped.hEvent;
+        if (p.open)
+            p.read();
+    }
+    bool processexited = false;
+    for (;;)
+    {
+        HANDLE handles[3];
+        pumpedpipe* owners[3] = {};
+        DWORD count = 0;
+        for (auto& p : pipes)
+        {
+            if (!p.open)
+                continue;
+            owners[count] = &p;
+            handles[count++] = p.overlapped.hEvent;
+        }
+        if (!processexited)
+            handles[count++] = process;
+        if (count == 0)
+            break;
+        // Once the game is gone only wait a moment for the rest of its output, a process
+        // it started may still hold the pipes open.
+        //
+        DWORD result = WaitForMultipleObjects(count, handles, FALSE, processexited ? 200 : INFINITE);
+        if (result == WAIT_TIMEOUT || result == WAIT_FAILED)
+            break;
+        DWORD index = result - WAIT_OBJECT_0;
+        if (index >= count)
+            break;
+        if (!owners[index])
+        {
+            processexited = true;
+            continue;
+        }
+        pumpedpipe& p = *owners[index];
+        DWORD bytesread = 0;
+        if (!GetOverlappedResult(p.pipe, &p.overlapped, &bytesread, FALSE))
+        {
+            p.open = false;
+            continue;
+        }
+        if (bytesread > 0 && onoutput)
+            onoutput(p.stream, p.buffer, bytesread);
+        p.read();
+    }
+    // Cancel the reads still in flight before their buffers go away.
+    //
+    for (auto& p : pipes)
+    {
+        if (p.open)
+        {
+            DWORD ignored = 0;
+            CancelIoEx(p.pipe, &p.overlapped);
+            GetOverlappedResult(p.pipe, &p.overlapped, &ignored, TRUE);
+        }
+        if (p.overlapped.hEvent)
+            CloseHandle(p.overlapped.hEvent);
+    }
+    return wait();
+}
+
+int childprocess::wait()
+{
+    if (exited || !process)
+        return exitcode;
+    WaitForSingleObject(process, INFINITE);
+    DWORD code = 0;
+    GetExitCodeProcess(process, &code);
+    exitcode = static_cast<int>(code);
+    exited = true;
+    return exitcode;
+}
+
+#else
+
+void childprocess::closehandles()
+{
+    for (int* fd : { &pidfd, &output, &errors })
+    {
+        if (*fd >= 0)
+            close(*fd);
+        *fd = -1;
+    }
+    // Reap a child nobody waited for, so it doesn't stay a zombie.
+    //
+    if (id > 0 && !exited)
+        waitpid(id, nullptr, WNOHANG);
+}
+
+bool childprocess::start(const processoptions& options)
+{
+    if (options.argv.empty())
+    {
+        message = "No program to start.";
+        return false;
+    }
+    int outpipe[2];
+    int errpipe[2];
+    if (pipe2(outpipe, O_CLOEXEC) != 0)
+    {
+        message = std::string("Failed to create stdout pipe: ") + std::strerror(errno);
+        return false;
+    }
+    if (pipe2(errpipe, O_CLOEXEC) != 0)
+    {
+        close(outpipe[0]);
+        close(outpipe[1]);
+        message = std::string("Failed to create stderr pipe: ") + std::strerror(errno);
+        return false;
+    }
+    // The child gets the write ends as stdout and stderr and /dev/null as stdin.
+    // Everything else is close-on-exec, so it inherits nothing more.
+    //
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, outpipe[1], 1);
+    posix_spawn_file_actions_adddup2(&actions, errpipe[1], 2);
+    int result = 0;
+    if (!options.cwd.empty())
+    {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+        result = posix_spawn_file_actions_addchdir_np(&actions, options.cwd.c_str());
+#else
+        result = ENOTSUP;
+#endif
+    }
+    std::vector<char*> args;
+    for (const auto& argument : options.argv)
+        args.push_back(const_cast<char*>(argument.c_str()));
+    args.push_back(nullptr);
+    std::vector<char*> envp;
+    for (const auto& entry : options.env)
+        envp.push_back(const_cast<char*>(entry.c_str()));
+    envp.push_back(nullptr);
+    pid_t child = -1;
+    if (result == 0)
+        result = posix_spawn(&child, args[0], &actions, nullptr, args.data(), options.env.empty() ? environ : envp.data());
+    posix_spawn_file_actions_destroy(&actions);
+    close(outpipe[1]);
+    close(errpipe[1]);
+    if (result != 0)
+    {
+        close(outpipe[0]);
+        close(errpipe[0]);
+        message = "posix_spawn failed: " + std::string(std::strerror(result));
+        return false;
+    }
+    id = child;
+    output = outpipe[0];
+    errors = errpipe[0];
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    // A pidfd becomes readable when the child exits, so it can be polled next to the pipes.
+    //
+    pidfd = static_cast<int>(syscall(SYS_pidfd_open, child, 0));
+#endif
+    return true;
+}
+
+// This function reads a non-blocking pipe until it is empty.
+// Returns false once the child closed its end.
+//
+static bool drainpipe(int fd, outputstream stream, char* buffer, const outputhandler& onoutput)
+{
+    for (;;)
+    {
+        ssize_t count = read(fd, buffer, pumpbuffersize);
+        if (count > 0)
+        {
+            if (onoutput)
+                onoutput(stream, buffer, static_cast<size_t>(count));
+            continue;
+        }
+        if (count < 0 && errno == EINTR)
+            continue;
+        return count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+}
+
+int childprocess::pump(const outputhandler& onoutput)
+{
+    if (id <= 0)
+        return exitcode;
+    char buffer[pumpbuffersize];
+    int* fds[2] = { &output, &errors };
+    const outputstream streams[2] = { outputstream::output, outputstream::error };
+    for (int* fd : fds)
+    {
+        if (*fd >= 0)
+            fcntl(*fd, F_SETFL, fcntl(*fd, F_GETFL) | O_NONBLOCK);
+    }
+    auto closepipe = [](int& fd)
+    {
+        close(fd);
+        fd = -1;
+    };
+#ifdef __linux__
+    // epoll over both pipes and the pidfd, which becomes readable when the child exits.
+    //
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll >= 0)
+    {
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            int fd = i < 2 ? *fds[i] : pidfd;
+            if (fd < 0)
+                continue;
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u32 = i;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+        }
+        bool processexited = false;
+        while ((output >= 0 || errors >= 0) && !processexited)
+        {
+            epoll_event events[3];
+            int count = epoll_wait(epoll, events, 3, -1);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0)
+                break;
+            for (int e = 0; e < count; e++)
+            {
+                uint32_t i = events[e].data.u32;
+                if (i == 2)
+                {
+                    processexited = true;
+                    continue;
+                }
+                if (*fds[i] >= 0 && !drainpipe(*fds[i], streams[i], buffer, onoutput))
+                {
+                    epoll_ctl(epoll, EPOLL_CTL_DEL, *fds[i], nullptr);
+                    closepipe(*fds[i]);
+                }
+            }
+        }
+        close(epoll);
+        // Whatever the game wrote before exiting is already in the pipes. A process it
+        // started may hold them open, so take what is there instead of waiting for EOF.
+        //
+        for (int i = 0; i < 2; i++)
+        {
+            if (*fds[i] >= 0)
+            {
+                drainpipe(*fds[i], streams[i], buffer, onoutput);
+                closepipe(*fds[i]);
+            }
+        }
+        return wait();
+    }
+#endif
+    // Without epoll or a pidfd, poll the pipes until the child closed both.
+    //
+    while (output >= 0 || errors >= 0)
+    {
+        pollfd polled[2];
+        int count = 0;
+        int owners[2];
+        for (int i = 0; i < 2; i++)
+        {
+            if (*fds[i] < 0)
+                continue;
+            polled[count].fd = *fds[i];
+            polled[count].events = POLLIN;
+            polled[count].revents = 0;
+            owners[count++] = i;
+        }
+        int ready = poll(polled, count, -1);
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready < 0)
+            break;
+        for (int p = 0; p < count; p++)
+        {
+            int i = owners[p];
+            if (polled[p].revents != 0 && !drainpipe(*fds[i], streams[i], buffer, onoutput))
+                closepipe(*fds[i]);
+        }
+    }
+    return wait();
+}
+
+int childprocess::wait()
+{
+    if (exited || id <= 0)
+        return exitcode;
+    int status = 0;
+    while (waitpid(id, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+            return exitcode;
+    }
+    if (WIFEXITED(status))
+        exitcode = WEXITSTATUS(status);
+    else if (WIFSIGNALED(status))
+        exitcode = 128 + WTERMSIG(status);
+    exited = true;
+    return exitcode;
+}
+
+#endif
@@ -0,0 +1,137 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/rules.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/utsname.h>
+#endif
+
+// This function describes the machine the launcher runs on.
+//
+platform platform::current()
+{
+    platform host;
+#if defined(_WIN32)
+    host.os = "windows";
+#elif defined(__APPLE__)
+    host.os = "osx";
+#else
+    host.os = "linux";
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+    host.arch = "arm64";
+#elif defined(__x86_64__) || defined(_M_X64)
+    host.arch = "x86_64";
+#else
+    host.arch = "x86";
+#endif
+    // The real OS version, GetVersionEx lies to processes without a manifest.
+    //
+#ifdef _WIN32
+    typedef LONG (WINAPI* rtlgetversion)(OSVERSIONINFOW*);
+    HMODULE ntdll = GetModuleHandleA("ntdll.dll");
+    rtlgetversion getversion = ntdll ? reinterpret_cast<rtlgetversion>(GetProcAddress(ntdll, "RtlGetVersion")) : nullptr;
+    OSVERSIONINFOW info{};
+    info.dwOSVersionInfoSize = sizeof(info);
+    if (getversion && getversion(&info) == 0)
+        host.version = std::to_string(info.dwMajorVersion) + "." + std::to_string(info.dwMinorVersion);
+#else
+    struct utsname name;
+    if (uname(&name) == 0)
+        host.version = name.release;
+#endif
+    return host;
+}
+
+std::string platform::nativesclassifier() const
+{
+    std::string classifier = "natives-" + std::string(os == "osx" ? "macos" : os);
+    if (arch == "arm64")
+        classifier += "-arm64";
+    else if (arch == "x86" && os == "windows")
+        classifier += "-x86";
+    return classifier;
+}
+
+bool platform::isnativelibrary(const std::string& filename) const
+{
+    auto endswith = [&](const char* suffix)
+    {
+        size_t length = std::char_traits<char>::length(suffix);
+        return filename.size() > length && filename.compare(filename.size() - length, length, suffix) == 0;
+    };
+    if (os == "windows")
+        return endswith(".dll");
+    if (os == "osx")
+        return endswith(".dylib") || endswith(".jnilib");
+    return endswith(".so");
+}
+
+// Only a handful of rules carry an os.version pattern (old macOS natives, the Windows 10
+// JVM flag), those are compiled here. A pattern that doesn't compile never matches.
+//
+rulepatterns::rulepatterns(const versionmanifest& manifest)
+{
+    indices.assign(manifest.rules.size(), nopattern);
+    for (uint32_t i = 0; i < manifest.rules.size(); i++)
+    {
+        const manifestrule& rule = manifest.rules[i];
+        if (rule.osversion.length == 0)
+            continue;
+        try {
+            compiled.emplace_back(manifest.string(rule.osversion));
+            indices[i] = static_cast<int32_t>(compiled.size() - 1);
+        } catch (const std::regex_error&) {
+            indices[i] = invalidpattern;
+        }
+    }
+}
+
+bool rulepatterns::versionmatches(uint32_t rule, const std::string& version) const
+{
+    int32_t index = rule < indices.size() ? indices[rule] : nopattern;
+    if (index == nopattern)
+        return true;
+    if (index == invalidpattern)
+        return false;
+    return std::regex_search(version, compiled[index]);
+}
+
+// Checks whether a single rule applies to this machine.
+//
+static bool rulematches(const versionmanifest& manifest, const rulepatterns& patterns, uint32_t index, const platform& host)
+{
+    const manifestrule& rule = manifest.rules[index];
+    if (rule.osname.length > 0 && manifest.str(rule.osname) != host.os)
+        return false;
+    if (rule.osarch.length > 0 && manifest.str(rule.osarch) != host.arch)
+        return false;
+    if (rule.osversion.length > 0 && !patterns.versionmatches(index, host.version))
+        return false;
+    for (uint32_t i = 0; i < rule.featurecount; i++)
+    {
+        const manifestfeature& feature = manifest.features[rule.firstfeature + i];
+        auto it = host.features.find(manifest.string(feature.name));
+        bool enabled = it != host.features.end() && it->second;
+        if ((feature.value != 0) != enabled)
+            return false;
+    }
+    return true;
+}
+
+bool rulesallow(const versionmanifest& manifest, const rulepatterns& patterns, uint32_t firstrule, uint32_t rulecount, const platform& host)
+{
+    if (rulecount == 0)
+        return true;
+    bool allowed = false;
+    for (uint32_t i = 0; i < rulecount; i++)
+    {
+        if (rulematches(manifest, patterns, firstrule + i, host))
+            allowed = manifest.rules[firstrule + i].allow != 0;
+    }
+    return allowed;
+}
@@ -0,0 +1,120 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/sha1.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static inline uint32_t rotl(uint32_t value, int bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+sha1hash::sha1hash()
+{
+    state[0] = 0x67452301;
+    state[1] = 0xEFCDAB89;
+    state[2] = 0x98BADCFE;
+    state[3] = 0x10325476;
+    state[4] = 0xC3D2E1F0;
+}
+
+// Processes one 64 byte block.
+//
+void sha1hash::transform(const uint8_t* block)
+{
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++)
+    {
+        w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16)
+             | (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 80; i++)
+        w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+    for (int i = 0; i < 80; i++)
+    {
+        uint32_t f, k;
+        if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+        else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+        else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+        else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+        uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = temp;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
+
+void sha1hash::update(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    length += size;
+    // Fill up a partial block first.
+    //
+    if (buffered > 0)
+    {
+        size_t take = std::min(size, sizeof(buffer) - buffered);
+        std::memcpy(buffer + buffered, bytes, take);
+        buffered += take;
+        bytes += take;
+        size -= take;
+        if (buffered < sizeof(buffer))
+            return;
+        transform(buffer);
+        buffered = 0;
+    }
+    while (size >= sizeof(buffer))
+    {
+        transform(bytes);
+        bytes += sizeof(buffer);
+        size -= sizeof(buffer);
+    }
+    std::memcpy(buffer, bytes, size);
+    buffered = size;
+}
+
+std::string sha1hash::hexdigest()
+{
+    uint64_t bits = length * 8;
+    uint8_t padding[64] = { 0x80 };
+    size_t padlength = (buffered < 56) ? (56 - buffered) : (120 - buffered);
+    update(padding, padlength);
+    uint8_t lengthbytes[8];
+    for (int i = 0; i < 8; i++)
+        lengthbytes[i] = uint8_t(bits >> (56 - i * 8));
+    update(lengthbytes, 8);
+
+    static const char* hex = "0123456789abcdef";
+    std::string digest;
+    digest.reserve(40);
+    for (uint32_t word : state)
+    {
+        for (int shift = 28; shift >= 0; shift -= 4)
+            digest += hex[(word >> shift) & 0xF];
+    }
+    return digest;
+}
+
+std::string sha1hash::file(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return "";
+    sha1hash hash;
+    char chunk[65536];
+    while (in.read(chunk, sizeof(chunk)) || in.gcount() > 0)
+        hash.update(chunk, static_cast<size_t>(in.gcount()));
+    return hash.hexdigest();
+}
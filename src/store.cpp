@@ -0,0 +1,60 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/store.hpp"
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+librarystore::librarystore(const std::string& root)
+    :root(root)
+{
+}
+
+const std::string& librarystore::path() const
+{
+    return root;
+}
+
+// This function maps a library from the version JSON to its file in the store.
+//
+std::string librarystore::resolve(const std::string& artifactpath, const std::string& sha1) const
+{
+    fs::path artifact = fs::path(artifactpath).make_preferred();
+    if (sha1.size() == 40)
+        return (fs::path(root) / sha1.substr(0, 2) / sha1 / artifact.filename()).make_preferred().string();
+    return (fs::path(root) / "maven" / artifact).make_preferred().string();
+}
+
+// This function moves an already downloaded jar into the store instead of downloading it again.
+// The downloader still checks its size and hash afterwards.
+//
+bool librarystore::adopt(const std::string& legacypath, const std::string& storepath) const
+{
+    std::error_code ec;
+    if (fs::exists(storepath, ec) || !fs::exists(legacypath, ec))
+        return false;
+    fs::create_directories(fs::path(storepath).parent_path(), ec);
+    fs::rename(legacypath, storepath, ec);
+    return !ec;
+}
+
+uint64_t librarystore::generation() const
+{
+    uint64_t value = 0;
+    std::ifstream f((fs::path(root) / "generation").string());
+    if (f)
+        f >> value;
+    return value;
+}
+
+void librarystore::bumpgeneration() const
+{
+    uint64_t value = generation() + 1;
+    fs::create_directories(root);
+    std::ofstream f((fs::path(root) / "generation").string(), std::ios::trunc);
+    f << value;
+}
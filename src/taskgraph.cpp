@@ -0,0 +1,111 @@
+// MIT License
+// Copyright (c) 2025 cornedev
+
+// Include headers.
+//
+#include "../include/taskgraph.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+taskgraph::taskgraph(std::function<void(const std::string&)> logger)
+    :logconsole(std::move(logger))
+{
+}
+
+taskgraph::nodeid taskgraph::add(const std::string& name, std::function<void()> work, const std::vector<nodeid>& dependencies)
+{
+    nodeid id = nodes.size();
+    node n;
+    n.name = name;
+    n.work = std::move(work);
+    n.remaining = dependencies.size();
+    nodes.push_back(std::move(n));
+    for (nodeid dependency : dependencies)
+    {
+        if (dependency >= id)
+            throw std::runtime_error("Task depends on a task added after it: " + name);
+        nodes[dependency].dependents.push_back(id);
+    }
+    return id;
+}
+
+// This function runs every node, each as soon as its inputs are ready.
+//
+bool taskgraph::run(size_t workers)
+{
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<nodeid> ready;
+    size_t finished = 0;
+    bool ok = true;
+    for (nodeid id = 0; id < nodes.size(); id++)
+    {
+        if (nodes[id].remaining == 0)
+            ready.push_back(id);
+    }
+    // Marks a node as done and releases its dependents, called with the mutex held.
+    //
+    std::function<void(nodeid, bool)> complete = [&](nodeid id, bool succeeded)
+    {
+        finished++;
+        for (nodeid dependent : nodes[id].dependents)
+        {
+            node& d = nodes[dependent];
+            if (!succeeded)
+                d.skipped = true;
+            if (--d.remaining > 0)
+                continue;
+            // A skipped node never runs, but still has to release its own dependents.
+            //
+            if (d.skipped)
+            {
+                ok = false;
+                if (logconsole)
+                    logconsole("[Skip] " + d.name + " (a previous step failed)");
+                complete(dependent, false);
+            }
+            else
+            {
+                ready.push_back(dependent);
+            }
+        }
+        wakeup.notify_all();
+    };
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wakeup.wait(lock, [&]() { return !ready.empty() || finished == nodes.size(); });
+            if (ready.empty())
+                return;
+            nodeid id = ready.front();
+            ready.pop_front();
+            lock.unlock();
+            bool succeeded = true;
+            try {
+                nodes[id].work();
+            } catch (const std::exception& e) {
+                succeeded = false;
+                if (logconsole)
+                    logconsole("[Error] " + nodes[id].name + " failed: " + e.what());
+            }
+            lock.lock();
+            if (!succeeded)
+                ok = false;
+            complete(id, succeeded);
+        }
+    };
+    if (workers == 0)
+        workers = 1;
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workers; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& t : threads)
+        t.join();
+    return ok;
+}